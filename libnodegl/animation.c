@@ -20,53 +20,81 @@
  */
 
 #include <float.h>
+#include <string.h>
+
 #include "animation.h"
 #include "log.h"
 #include "math_utils.h"
+#include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "utils.h"
 
-static int get_kf_id(struct ngl_node * const *animkf, int nb_animkf, int start, double t)
+/*
+ * Return the index of the last key frame starting at or before t, or -1 if t
+ * is before the first key frame.
+ */
+static int get_kf_id(const struct animation *s, double t)
 {
-    int ret = -1;
+    const double *times = s->kf_times;
+    const int last = s->nb_kfs - 1;
+    const int cur = s->current_kf;
+
+    /*
+     * Forward playback: t is usually in the current key frame or in one of the
+     * few following it
+     */
+    if (times[cur] <= t) {
+        const int end = NGLI_MIN(cur + 2, last);
+        int i = cur;
+        while (i < end && times[i + 1] <= t)
+            i++;
+        if (i == last || t < times[i + 1])
+            return i;
+    }
 
-    for (int i = start; i < nb_animkf; i++) {
-        const struct animkeyframe_priv *kf = animkf[i]->priv_data;
-        if (kf->time > t)
-            break;
-        ret = i;
+    /* Seeking: binary search of the first key frame starting after t */
+    int lo = 0;
+    int hi = s->nb_kfs;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (times[mid] <= t)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
-    return ret;
+    return lo - 1;
 }
 
 int ngli_animation_evaluate(struct animation *s, void *dst, double t)
 {
-    struct ngl_node * const *animkf = s->kfs;
     const int nb_animkf = s->nb_kfs;
     if (!nb_animkf)
         return 0;
-    int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id < 0)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const int kf_id = get_kf_id(s, t);
+    if (kf_id >= 0)
+        s->current_kf = kf_id;
     if (kf_id >= 0 && kf_id < nb_animkf - 1) {
-        const struct animkeyframe_priv *kf0 = animkf[kf_id    ]->priv_data;
-        const struct animkeyframe_priv *kf1 = animkf[kf_id + 1]->priv_data;
-        const double t0 = kf0->time;
-        const double t1 = kf1->time;
+        const struct animkeyframe_priv *kf0 = s->kfs[kf_id    ];
+        const struct animkeyframe_priv *kf1 = s->kfs[kf_id + 1];
+        const double t0 = s->kf_times[kf_id    ];
+        const double t1 = s->kf_times[kf_id + 1];
 
         double tnorm = NGLI_LINEAR_INTERP(t0, t1, t);
-        if (kf1->scale_boundaries)
-            tnorm = NGLI_MIX(kf1->offsets[0], kf1->offsets[1], tnorm);
-        double ratio = kf1->function(tnorm, kf1->nb_args, kf1->args);
-        if (kf1->scale_boundaries)
-            ratio = NGLI_LINEAR_INTERP(kf1->boundaries[0], kf1->boundaries[1], ratio);
+        double ratio;
+        if (kf1->lut.values) {
+            ratio = ngli_easing_lut_evaluate(&kf1->lut, tnorm);
+        } else {
+            if (kf1->scale_boundaries)
+                tnorm = NGLI_MIX(kf1->offsets[0], kf1->offsets[1], tnorm);
+            ratio = kf1->function(tnorm, kf1->nb_args, kf1->args);
+            if (kf1->scale_boundaries)
+                ratio = NGLI_LINEAR_INTERP(kf1->boundaries[0], kf1->boundaries[1], ratio);
+        }
 
-        s->current_kf = kf_id;
         s->mix_func(s->user_arg, dst, kf0, kf1, ratio);
     } else {
-        const struct animkeyframe_priv *kf0 = animkf[            0]->priv_data;
-        const struct animkeyframe_priv *kfn = animkf[nb_animkf - 1]->priv_data;
-        const struct animkeyframe_priv *kf  = t < kf0->time ? kf0 : kfn;
+        const struct animkeyframe_priv *kf = kf_id < 0 ? s->kfs[0] : s->kfs[nb_animkf - 1];
         s->cpy_func(s->user_arg, dst, kf);
     }
     return 0;
@@ -74,18 +102,17 @@ int ngli_animation_evaluate(struct animation *s, void *dst, double t)
 
 int ngli_animation_derivate(struct animation *s, void *dst, double t)
 {
-    struct ngl_node * const *animkf = s->kfs;
     const int nb_animkf = s->nb_kfs;
     if (!nb_animkf)
         return 0;
-    int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id < 0)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const int kf_id = get_kf_id(s, t);
+    if (kf_id >= 0)
+        s->current_kf = kf_id;
     if (kf_id >= 0 && kf_id < nb_animkf - 1) {
-        const struct animkeyframe_priv *kf0 = animkf[kf_id    ]->priv_data;
-        const struct animkeyframe_priv *kf1 = animkf[kf_id + 1]->priv_data;
-        const double t0 = kf0->time;
-        const double t1 = kf1->time;
+        const struct animkeyframe_priv *kf0 = s->kfs[kf_id    ];
+        const struct animkeyframe_priv *kf1 = s->kfs[kf_id + 1];
+        const double t0 = s->kf_times[kf_id    ];
+        const double t1 = s->kf_times[kf_id + 1];
 
         double tnorm = NGLI_LINEAR_INTERP(t0, t1, t);
         if (kf1->scale_boundaries)
@@ -94,17 +121,30 @@ int ngli_animation_derivate(struct animation *s, void *dst, double t)
         if (kf1->scale_boundaries)
             ratio *= kf1->derivative_scale;
 
-        s->current_kf = kf_id;
         s->mix_func(s->user_arg, dst, kf0, kf1, ratio);
     } else {
-        const struct animkeyframe_priv *kf0 = animkf[            0]->priv_data;
-        const struct animkeyframe_priv *kfn = animkf[nb_animkf - 1]->priv_data;
-        const struct animkeyframe_priv *kf  = t < kf0->time ? kf0 : kfn;
+        const struct animkeyframe_priv *kf = kf_id < 0 ? s->kfs[0] : s->kfs[nb_animkf - 1];
         s->cpy_func(s->user_arg, dst, kf);
     }
     return 0;
 }
 
+int ngli_animation_refresh_times(struct animation *s)
+{
+    double prev_time = -DBL_MAX;
+    for (int i = 0; i < s->nb_kfs; i++) {
+        const double time = s->kfs[i]->time;
+        if (time < prev_time) {
+            LOG(ERROR, "key frames must be monotonically increasing: %g < %g",
+                time, prev_time);
+            return NGL_ERROR_INVALID_ARG;
+        }
+        s->kf_times[i] = time;
+        prev_time = time;
+    }
+    return 0;
+}
+
 int ngli_animation_init(struct animation *s, void *user_arg,
                         struct ngl_node * const *kfs, int nb_kfs,
                         ngli_animation_mix_func_type mix_func,
@@ -116,20 +156,37 @@ int ngli_animation_init(struct animation *s, void *user_arg,
     s->mix_func = mix_func;
     s->cpy_func = cpy_func;
 
-    double prev_time = -DBL_MAX;
-    for (int i = 0; i < nb_kfs; i++) {
-        const struct animkeyframe_priv *kf = kfs[i]->priv_data;
+    if (!nb_kfs)
+        return 0;
 
-        if (kf->time < prev_time) {
-            LOG(ERROR, "key frames must be monotonically increasing: %g < %g",
-                kf->time, prev_time);
-            return NGL_ERROR_INVALID_ARG;
-        }
-        prev_time = kf->time;
+    /*
+     * The key frame times are packed so that the lookups only go through a
+     * contiguous array instead of dereferencing every key frame node.
+     */
+    s->kf_times = ngli_calloc(nb_kfs, sizeof(*s->kf_times));
+    s->kfs = ngli_calloc(nb_kfs, sizeof(*s->kfs));
+    if (!s->kf_times || !s->kfs) {
+        ngli_animation_reset(s);
+        return NGL_ERROR_MEMORY;
     }
 
-    s->kfs = kfs;
+    for (int i = 0; i < nb_kfs; i++)
+        s->kfs[i] = kfs[i]->priv_data;
     s->nb_kfs = nb_kfs;
+    s->current_kf = 0;
+
+    int ret = ngli_animation_refresh_times(s);
+    if (ret < 0) {
+        ngli_animation_reset(s);
+        return ret;
+    }
 
     return 0;
 }
+
+void ngli_animation_reset(struct animation *s)
+{
+    ngli_freep(&s->kf_times);
+    ngli_freep(&s->kfs);
+    memset(s, 0, sizeof(*s));
+}
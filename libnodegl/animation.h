@@ -35,9 +35,10 @@ typedef void (*ngli_animation_cpy_func_type)(void *user_arg, void *dst,
                                              const struct animkeyframe_priv *kf);
 
 struct animation {
-    struct ngl_node * const *kfs;
     int nb_kfs;
-    int current_kf;
+    int current_kf; /* first key frame of the last interpolation */
+    double *kf_times; /* packed key frame times, used for the lookups */
+    const struct animkeyframe_priv **kfs;
     void *user_arg;
     ngli_animation_mix_func_type mix_func;
     ngli_animation_cpy_func_type cpy_func;
@@ -48,7 +49,14 @@ int ngli_animation_init(struct animation *s, void *user_arg,
                         ngli_animation_mix_func_type mix_func,
                         ngli_animation_cpy_func_type cpy_func);
 
+/*
+ * Copy the key frame times again, for when they may have been changed since
+ * the init (standalone evaluation).
+ */
+int ngli_animation_refresh_times(struct animation *s);
+
 int ngli_animation_evaluate(struct animation *s, void *dst, double t);
 int ngli_animation_derivate(struct animation *s, void *dst, double t);
+void ngli_animation_reset(struct animation *s);
 
 #endif
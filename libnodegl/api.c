@@ -32,15 +32,20 @@
 #include "jni_utils.h"
 #endif
 
+#include "cmdring.h"
 #include "darray.h"
+#include "drawlist.h"
 #include "gpu_ctx.h"
 #include "graphicstate.h"
 #include "log.h"
+#include "lookahead.h"
 #include "math_utils.h"
 #include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "pathcache.h"
 #include "pgcache.h"
+#include "prefetcher.h"
 #include "rnode.h"
 #include "pthread_compat.h"
 
@@ -84,6 +89,8 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 {
     if (s->gpu_ctx)
         ngli_gpu_ctx_wait_idle(s->gpu_ctx);
+    ngli_drawlist_freep(&s->drawlist);
+    ngli_lookahead_freep(&s->lookahead);
     if (s->scene) {
         ngli_node_detach_ctx(s->scene, s);
         if (*(int *)arg == UNREF_SCENE)
@@ -98,7 +105,10 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 #endif
     ngli_texture_freep(&s->font_atlas); // allocated by the first node text
     ngli_pgcache_reset(&s->pgcache);
+    ngli_pathcache_reset(&s->pathcache);
     ngli_hud_freep(&s->hud);
+    ngli_threadpool_freep(&s->update_pool);
+    ngli_prefetcher_freep(&s->prefetcher);
     ngli_gpu_ctx_freep(&s->gpu_ctx);
 
     return 0;
@@ -141,6 +151,10 @@ static int cmd_configure(struct ngl_ctx *s, void *arg)
     if (ret < 0)
         return ret;
 
+    ret = ngli_pathcache_init(&s->pathcache);
+    if (ret < 0)
+        return ret;
+
 #if defined(HAVE_VAAPI)
     ret = ngli_vaapi_ctx_init(s->gpu_ctx, &s->vaapi_ctx);
     if (ret < 0)
@@ -154,6 +168,16 @@ static int cmd_configure(struct ngl_ctx *s, void *arg)
         LOG(WARNING, "could not initialize Android context");
 #endif
 
+    if (config->nb_update_threads > 1) {
+        s->update_pool = ngli_threadpool_create(config->nb_update_threads);
+        if (!s->update_pool)
+            return NGL_ERROR_MEMORY;
+    }
+
+    s->prefetcher = ngli_prefetcher_create();
+    if (!s->prefetcher)
+        return NGL_ERROR_MEMORY;
+
     NGLI_ALIGNED_MAT(matrix) = NGLI_MAT4_IDENTITY;
     ngli_gpu_ctx_transform_projection_matrix(s->gpu_ctx, matrix);
     ngli_darray_clear(&s->projection_matrix_stack);
@@ -200,6 +224,8 @@ static int cmd_set_capture_buffer(struct ngl_ctx *s, void *capture_buffer)
 
     int ret = ngli_gpu_ctx_set_capture_buffer(s->gpu_ctx, capture_buffer);
     if (ret < 0) {
+        ngli_drawlist_freep(&s->drawlist);
+        ngli_lookahead_freep(&s->lookahead);
         if (s->scene) {
             ngli_node_detach_ctx(s->scene, s);
             ngl_node_unrefp(&s->scene);
@@ -217,6 +243,8 @@ static int cmd_set_scene(struct ngl_ctx *s, void *arg)
 {
     ngli_gpu_ctx_wait_idle(s->gpu_ctx);
 
+    ngli_drawlist_freep(&s->drawlist);
+    ngli_lookahead_freep(&s->lookahead);
     if (s->scene) {
         ngli_node_detach_ctx(s->scene, s);
         ngl_node_unrefp(&s->scene);
@@ -260,6 +288,8 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
 {
     const double t = *(double *)arg;
 
+    s->upload_size = 0;
+
     struct ngl_node *scene = s->scene;
     if (!scene) {
         return 0;
@@ -269,7 +299,21 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
 
     const int64_t start_time = s->hud ? ngli_gettime_relative() : 0;
 
+    const struct ngl_config *config = &s->config;
+    if (config->lookahead_time > 0. && !s->lookahead) {
+        s->lookahead = ngli_lookahead_create(s);
+        if (!s->lookahead)
+            return NGL_ERROR_MEMORY;
+        int ret = ngli_lookahead_init(s->lookahead, scene);
+        if (ret < 0) {
+            ngli_lookahead_freep(&s->lookahead);
+            return ret;
+        }
+    }
+
     ngli_darray_clear(&s->activitycheck_nodes);
+    ngli_darray_clear(&s->visited_nodes);
+    s->visit_epoch++;
     int ret = ngli_node_visit(scene, 1, t);
     if (ret < 0)
         return ret;
@@ -278,6 +322,22 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
     if (ret < 0)
         return ret;
 
+    if (s->lookahead) {
+        ret = ngli_lookahead_run(s->lookahead, t);
+        if (ret < 0)
+            return ret;
+    }
+
+    /*
+     * The pool takes care of the thread-safe branches of the graph, the
+     * remaining nodes (and GPU operations) are updated on this thread.
+     */
+    if (s->update_pool) {
+        ret = ngli_node_update_parallel(s, t);
+        if (ret < 0)
+            return ret;
+    }
+
     ret = ngli_node_update(scene, t);
     if (ret < 0)
         return ret;
@@ -310,7 +370,21 @@ static int cmd_draw(struct ngl_ctx *s, void *arg)
     struct ngl_node *scene = s->scene;
     if (scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", scene->label, t);
-        ngli_node_draw(scene);
+        if (!s->drawlist) {
+            s->drawlist = ngli_drawlist_create(s);
+            if (!s->drawlist) {
+                ret = NGL_ERROR_MEMORY;
+                goto end;
+            }
+            ret = ngli_drawlist_compile(s->drawlist, scene);
+            if (ret < 0) {
+                ngli_drawlist_freep(&s->drawlist);
+                goto end;
+            }
+        }
+        ret = ngli_drawlist_exec(s->drawlist);
+        if (ret < 0)
+            goto end;
     }
 
     if (s->hud) {
@@ -334,17 +408,23 @@ end:;
     return ret;
 }
 
+/*
+ * At most NGLI_MAX_PENDING_DRAWS asynchronous draws and one synchronous
+ * command can be in flight, plus the slot always left empty by the ring
+ */
+#define CMDRING_SIZE 4
+
+struct cmd {
+    cmd_func_type func;
+    void *arg;
+};
+
 static int dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
 {
-    pthread_mutex_lock(&s->lock);
-    s->cmd_func = cmd_func;
-    s->cmd_arg = arg;
-    pthread_cond_signal(&s->cond_wkr);
-    while (s->cmd_func)
-        pthread_cond_wait(&s->cond_ctl, &s->lock);
-    pthread_mutex_unlock(&s->lock);
-
-    return s->cmd_ret;
+    const struct cmd cmd = {.func = cmd_func, .arg = arg};
+    struct cmdring_completion completion;
+    ngli_cmdring_push(s->cmdring, &cmd, &completion);
+    return ngli_cmdring_wait(s->cmdring, &completion);
 }
 
 static void *worker_thread(void *arg)
@@ -353,19 +433,15 @@ static void *worker_thread(void *arg)
 
     ngli_thread_set_name("ngl-thread");
 
-    pthread_mutex_lock(&s->lock);
     for (;;) {
-        while (!s->cmd_func)
-            pthread_cond_wait(&s->cond_wkr, &s->lock);
-        s->cmd_ret = s->cmd_func(s, s->cmd_arg);
-        int need_stop = s->cmd_func == cmd_stop;
-        s->cmd_func = s->cmd_arg = NULL;
-        pthread_cond_signal(&s->cond_ctl);
-
-        if (need_stop)
+        struct cmd cmd;
+        struct cmdring_completion *completion;
+        ngli_cmdring_pop(s->cmdring, &cmd, &completion);
+        const int ret = cmd.func(s, cmd.arg);
+        ngli_cmdring_complete(s->cmdring, completion, ret);
+        if (cmd.func == cmd_stop)
             break;
     }
-    pthread_mutex_unlock(&s->lock);
 
     return NULL;
 }
@@ -596,13 +672,10 @@ struct ngl_ctx *ngl_create(void)
     if (!s)
         return NULL;
 
-    if (pthread_mutex_init(&s->lock, NULL) ||
-        pthread_cond_init(&s->cond_ctl, NULL) ||
-        pthread_cond_init(&s->cond_wkr, NULL) ||
+    s->cmdring = ngli_cmdring_create(CMDRING_SIZE, sizeof(struct cmd));
+    if (!s->cmdring ||
         pthread_create(&s->worker_tid, NULL, worker_thread, s)) {
-        pthread_cond_destroy(&s->cond_ctl);
-        pthread_cond_destroy(&s->cond_wkr);
-        pthread_mutex_destroy(&s->lock);
+        ngli_cmdring_freep(&s->cmdring);
         ngli_free(s);
         return NULL;
     }
@@ -610,6 +683,10 @@ struct ngl_ctx *ngl_create(void)
     ngli_darray_init(&s->modelview_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->projection_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->activitycheck_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->visited_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->update_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->update_level_counts, sizeof(int), 0);
+    ngli_darray_init(&s->params_pending_nodes, sizeof(struct ngl_node *), 0);
 
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
     if (!ngli_darray_push(&s->modelview_matrix_stack, id_matrix) ||
@@ -714,6 +791,11 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    if (s->params_batch) {
+        LOG(ERROR, "pending parameter changes must be committed before setting a scene");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
     return dispatch_cmd(s, cmd_set_scene, scene);
 }
 
@@ -724,6 +806,11 @@ int ngli_prepare_draw(struct ngl_ctx *s, double t)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    if (s->params_batch) {
+        LOG(ERROR, "pending parameter changes must be committed before updating");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
     return dispatch_cmd(s, cmd_prepare_draw, &t);
 }
 
@@ -734,9 +821,129 @@ int ngl_draw(struct ngl_ctx *s, double t)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    if (s->params_batch) {
+        LOG(ERROR, "pending parameter changes must be committed before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
     return dispatch_cmd(s, cmd_draw, &t);
 }
 
+struct draw_range_params {
+    const double *times;
+    int nb_times;
+    ngl_draw_callback callback;
+    void *user_arg;
+};
+
+static int cmd_draw_range(struct ngl_ctx *s, void *arg)
+{
+    const struct draw_range_params *params = arg;
+
+    for (int i = 0; i < params->nb_times; i++) {
+        double t = params->times[i];
+        int ret = cmd_draw(s, &t);
+        if (ret < 0)
+            return ret;
+        if (params->callback) {
+            ret = params->callback(params->user_arg, i, t);
+            if (ret < 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+int ngl_draw_range(struct ngl_ctx *s, const double *times, int nb_times,
+                   ngl_draw_callback callback, void *user_arg)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (s->params_batch) {
+        LOG(ERROR, "pending parameter changes must be committed before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (nb_times < 0 || (nb_times && !times))
+        return NGL_ERROR_INVALID_ARG;
+
+    struct draw_range_params params = {
+        .times    = times,
+        .nb_times = nb_times,
+        .callback = callback,
+        .user_arg = user_arg,
+    };
+    return dispatch_cmd(s, cmd_draw_range, &params);
+}
+
+static void collect_async_draw(struct ngl_ctx *s)
+{
+    struct cmdring_completion *completion = &s->pending_draws_completions[s->pending_draws_start];
+    const int ret = ngli_cmdring_wait(s->cmdring, completion);
+    if (ret < 0 && !s->async_draw_ret)
+        s->async_draw_ret = ret;
+    s->pending_draws_start = (s->pending_draws_start + 1) % NGLI_MAX_PENDING_DRAWS;
+    s->nb_pending_draws--;
+}
+
+static int pop_async_draw_ret(struct ngl_ctx *s)
+{
+    const int ret = s->async_draw_ret;
+    s->async_draw_ret = 0;
+    return ret;
+}
+
+/*
+ * Errors of the collected draws are kept for the next ngl_draw_async() or
+ * ngl_wait() call
+ */
+void ngli_wait_async_draws(struct ngl_ctx *s)
+{
+    while (s->nb_pending_draws)
+        collect_async_draw(s);
+}
+
+int ngl_draw_async(struct ngl_ctx *s, double t)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (s->params_batch) {
+        LOG(ERROR, "pending parameter changes must be committed before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    while (s->nb_pending_draws &&
+           ngli_cmdring_poll(s->cmdring, &s->pending_draws_completions[s->pending_draws_start]))
+        collect_async_draw(s);
+    if (s->nb_pending_draws == NGLI_MAX_PENDING_DRAWS)
+        collect_async_draw(s);
+
+    const int ret = pop_async_draw_ret(s);
+    if (ret < 0)
+        return ret;
+
+    const int pos = (s->pending_draws_start + s->nb_pending_draws) % NGLI_MAX_PENDING_DRAWS;
+    s->pending_draws[pos] = t;
+    const struct cmd cmd = {.func = cmd_draw, .arg = &s->pending_draws[pos]};
+    ngli_cmdring_push(s->cmdring, &cmd, &s->pending_draws_completions[pos]);
+    s->nb_pending_draws++;
+
+    return 0;
+}
+
+int ngl_wait(struct ngl_ctx *s)
+{
+    ngli_wait_async_draws(s);
+    return pop_async_draw_ret(s);
+}
+
 void ngl_freep(struct ngl_ctx **ss)
 {
     struct ngl_ctx *s = *ss;
@@ -744,15 +951,22 @@ void ngl_freep(struct ngl_ctx **ss)
     if (!s)
         return;
 
+    /* Drop the uncommitted parameter changes while the nodes are still alive */
+    struct ngl_node **pending_nodes = ngli_darray_data(&s->params_pending_nodes);
+    for (int i = 0; i < ngli_darray_count(&s->params_pending_nodes); i++)
+        pending_nodes[i]->params_pending = 0;
+
     dispatch_cmd(s, cmd_stop, &(int[]){UNREF_SCENE});
     pthread_join(s->worker_tid, NULL);
-    pthread_cond_destroy(&s->cond_ctl);
-    pthread_cond_destroy(&s->cond_wkr);
-    pthread_mutex_destroy(&s->lock);
+    ngli_cmdring_freep(&s->cmdring);
 
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+    ngli_darray_reset(&s->visited_nodes);
+    ngli_darray_reset(&s->update_nodes);
+    ngli_darray_reset(&s->update_level_counts);
+    ngli_darray_reset(&s->params_pending_nodes);
     ngli_freep(ss);
 }
 
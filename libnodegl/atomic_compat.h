@@ -0,0 +1,74 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef ATOMIC_COMPAT_H
+#define ATOMIC_COMPAT_H
+
+/*
+ * Minimal sequentially consistent atomic operations on int, since the C11
+ * <stdatomic.h> header is not available to our C99 code base (and MSVC).
+ * ngli_atomic_fence() also orders the plain memory accesses around it.
+ */
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static inline int ngli_atomic_load(volatile int *p)
+{
+    return _InterlockedOr((volatile long *)p, 0);
+}
+
+static inline void ngli_atomic_store(volatile int *p, int v)
+{
+    _InterlockedExchange((volatile long *)p, v);
+}
+
+static inline int ngli_atomic_add(volatile int *p, int v)
+{
+    return _InterlockedExchangeAdd((volatile long *)p, v) + v;
+}
+
+#if defined(_M_IX86) || defined(_M_X64)
+#define ngli_cpu_relax() _mm_pause()
+#define ngli_atomic_fence() _mm_mfence()
+#else
+#define ngli_cpu_relax() __yield()
+#define ngli_atomic_fence() __dmb(_ARM64_BARRIER_ISH)
+#endif
+
+#else
+
+#define ngli_atomic_load(p)     __atomic_load_n(p, __ATOMIC_SEQ_CST)
+#define ngli_atomic_store(p, v) __atomic_store_n(p, v, __ATOMIC_SEQ_CST)
+#define ngli_atomic_add(p, v)   __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST)
+#define ngli_atomic_fence()     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+#if defined(__i386__) || defined(__x86_64__)
+#define ngli_cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define ngli_cpu_relax() __asm__ __volatile__("yield")
+#else
+#define ngli_cpu_relax() do { } while (0)
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "buffer_mix.h"
+#include "gpu_ctx.h"
+#include "log.h"
+#include "nodes.h"
+#include "type.h"
+#include "utils.h"
+
+#define WORKGROUP_SIZE 64
+
+/*
+ * The interpolation is written out instead of using mix() so the result
+ * matches ngli_mix_f32() bit for bit. The precise qualifier prevents the
+ * compiler from contracting it into a fused multiply-add; it is not available
+ * before GLSL ES 3.20, where the result may differ in the last bits.
+ */
+static const char *comp_base =
+    "#if defined(GL_ES) && __VERSION__ < 320"                                   "\n"
+    "#define ngl_precise"                                                       "\n"
+    "#else"                                                                     "\n"
+    "#define ngl_precise precise"                                               "\n"
+    "#endif"                                                                    "\n"
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    uint n = uint(dst.data.length());"                                     "\n"
+    "    uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;"                "\n"
+    "    uvec2 offsets = uvec2(src_offsets);"                                   "\n"
+    "    for (uint i = gl_GlobalInvocationID.x; i < n; i += stride) {"          "\n"
+    "        ngl_precise float v = src.data[offsets.x + i] * (1.0 - ratio)"     "\n"
+    "                            + src.data[offsets.y + i] * ratio;"            "\n"
+    "        dst.data[i] = v;"                                                  "\n"
+    "    }"                                                                     "\n"
+    "}";
+
+int ngli_buffer_mix_init(struct buffer_mix *s, struct ngl_ctx *ctx, struct buffer *dst,
+                         const float * const *srcs, int nb_srcs, int nb_values)
+{
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    const struct gpu_limits *limits = &gpu_ctx->limits;
+
+    s->ctx = ctx;
+    s->nb_values = nb_values;
+
+    /* The shader loops over the values in excess of the dispatch size */
+    const int nb_groups = (nb_values + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+    s->nb_groups = NGLI_MIN(nb_groups, limits->max_compute_work_group_count[0]);
+
+    ngli_block_init(&s->src_block, NGLI_BLOCK_LAYOUT_STD430);
+    ngli_block_init(&s->dst_block, NGLI_BLOCK_LAYOUT_STD430);
+    int ret;
+    if ((ret = ngli_block_add_field(&s->src_block, "data", NGLI_TYPE_FLOAT, nb_srcs * nb_values)) < 0 ||
+        (ret = ngli_block_add_field(&s->dst_block, "data", NGLI_TYPE_FLOAT, nb_values)) < 0)
+        return ret;
+
+    s->src_buffer = ngli_buffer_create(gpu_ctx);
+    if (!s->src_buffer)
+        return NGL_ERROR_MEMORY;
+
+    const int src_size = nb_values * sizeof(**srcs);
+    ret = ngli_buffer_init(s->src_buffer, nb_srcs * src_size, NGLI_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                               NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    if (ret < 0)
+        return ret;
+
+    for (int i = 0; i < nb_srcs; i++) {
+        ret = ngli_buffer_upload(s->src_buffer, srcs[i], src_size, i * src_size);
+        if (ret < 0)
+            return ret;
+    }
+
+    static const int offsets[2];
+    static const float ratio;
+    const struct pgcraft_uniform uniforms[] = {
+        {.name = "src_offsets", .type = NGLI_TYPE_IVEC2, .stage = NGLI_PROGRAM_SHADER_COMP, .data = offsets},
+        {.name = "ratio",       .type = NGLI_TYPE_FLOAT, .stage = NGLI_PROGRAM_SHADER_COMP, .data = &ratio},
+    };
+
+    const struct pgcraft_block blocks[] = {
+        {
+            .name   = "src",
+            .type   = NGLI_TYPE_STORAGE_BUFFER,
+            .stage  = NGLI_PROGRAM_SHADER_COMP,
+            .block  = &s->src_block,
+            .buffer = s->src_buffer,
+        }, {
+            .name     = "dst",
+            .type     = NGLI_TYPE_STORAGE_BUFFER,
+            .stage    = NGLI_PROGRAM_SHADER_COMP,
+            .writable = 1,
+            .block    = &s->dst_block,
+            .buffer   = dst,
+        },
+    };
+
+    struct pipeline_params pipeline_params = {
+        .type = NGLI_PIPELINE_TYPE_COMPUTE,
+    };
+
+    const struct pgcraft_params crafter_params = {
+        .comp_base      = comp_base,
+        .uniforms       = uniforms,
+        .nb_uniforms    = NGLI_ARRAY_NB(uniforms),
+        .blocks         = blocks,
+        .nb_blocks      = NGLI_ARRAY_NB(blocks),
+        .workgroup_size = {WORKGROUP_SIZE, 1, 1},
+    };
+
+    s->crafter = ngli_pgcraft_create(ctx);
+    if (!s->crafter)
+        return NGL_ERROR_MEMORY;
+
+    struct pipeline_resource_params pipeline_resource_params = {0};
+    ret = ngli_pgcraft_craft(s->crafter, &pipeline_params, &pipeline_resource_params, &crafter_params);
+    if (ret < 0)
+        return ret;
+
+    s->pipeline = ngli_pipeline_create(gpu_ctx);
+    if (!s->pipeline)
+        return NGL_ERROR_MEMORY;
+
+    ret = ngli_pipeline_init(s->pipeline, &pipeline_params);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_pipeline_set_resources(s->pipeline, &pipeline_resource_params);
+    if (ret < 0)
+        return ret;
+
+    s->offsets_index = ngli_pgcraft_get_uniform_index(s->crafter, "src_offsets", NGLI_PROGRAM_SHADER_COMP);
+    s->ratio_index = ngli_pgcraft_get_uniform_index(s->crafter, "ratio", NGLI_PROGRAM_SHADER_COMP);
+
+    return 0;
+}
+
+int ngli_buffer_mix_exec(struct buffer_mix *s, int src0, int src1, float ratio)
+{
+    const int offsets[] = {src0 * s->nb_values, src1 * s->nb_values};
+    ngli_pipeline_update_uniform(s->pipeline, s->offsets_index, offsets);
+    ngli_pipeline_update_uniform(s->pipeline, s->ratio_index, &ratio);
+    ngli_pipeline_dispatch(s->pipeline, s->nb_groups, 1, 1);
+    return 0;
+}
+
+void ngli_buffer_mix_reset(struct buffer_mix *s)
+{
+    if (!s->ctx)
+        return;
+
+    ngli_pipeline_freep(&s->pipeline);
+    ngli_pgcraft_freep(&s->crafter);
+    ngli_buffer_freep(&s->src_buffer);
+    ngli_block_reset(&s->src_block);
+    ngli_block_reset(&s->dst_block);
+
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef BUFFER_MIX_H
+#define BUFFER_MIX_H
+
+#include "block.h"
+#include "buffer.h"
+#include "pgcraft.h"
+#include "pipeline.h"
+
+struct ngl_ctx;
+
+/*
+ * Interpolate between two of a set of float buffers on the GPU: the source
+ * buffers are uploaded once and each mix is a compute dispatch writing to the
+ * destination buffer.
+ */
+struct buffer_mix {
+    struct ngl_ctx *ctx;
+    int nb_values;
+    int nb_groups;
+
+    struct block src_block;
+    struct block dst_block;
+    struct buffer *src_buffer;
+    struct pgcraft *crafter;
+    struct pipeline *pipeline;
+    int offsets_index;
+    int ratio_index;
+};
+
+int ngli_buffer_mix_init(struct buffer_mix *s, struct ngl_ctx *ctx, struct buffer *dst,
+                         const float * const *srcs, int nb_srcs, int nb_values);
+int ngli_buffer_mix_exec(struct buffer_mix *s, int src0, int src1, float ratio);
+void ngli_buffer_mix_reset(struct buffer_mix *s);
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "atomic_compat.h"
+#include "cmdring.h"
+#include "memory.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+#define MIN_SPINS 16
+#define MAX_SPINS 4096
+
+struct waiter {
+    pthread_cond_t cond;
+    int parked;     /* accessed atomically */
+    int nb_spins;   /* only accessed by the waiting thread */
+};
+
+struct cmdring {
+    int min_spins;
+    int max_spins;
+    uint8_t *elems;
+    struct cmdring_completion **completions;
+    size_t elem_size;
+    int mask;
+    int head;       /* written by the consumer only, accessed atomically */
+    int tail;       /* written by the producer only, accessed atomically */
+    pthread_mutex_t lock;
+    struct waiter producer;
+    struct waiter consumer;
+};
+
+typedef int (*check_func)(const struct cmdring *s, void *arg);
+
+static int has_free_slot(const struct cmdring *s, void *arg)
+{
+    return ((s->tail + 1) & s->mask) != ngli_atomic_load((int *)&s->head);
+}
+
+static int has_pending_elem(const struct cmdring *s, void *arg)
+{
+    return ngli_atomic_load((int *)&s->tail) != s->head;
+}
+
+static int is_completed(const struct cmdring *s, void *arg)
+{
+    struct cmdring_completion *completion = arg;
+    return ngli_atomic_load(&completion->done);
+}
+
+static void wait_for(struct cmdring *s, struct waiter *w, check_func check, void *arg)
+{
+    for (int i = 0; i < w->nb_spins; i++) {
+        if (check(s, arg)) {
+            w->nb_spins = NGLI_MIN(w->nb_spins * 2, s->max_spins);
+            return;
+        }
+        ngli_cpu_relax();
+    }
+
+    /*
+     * The parked flag is raised before checking the condition one last time,
+     * while the waking side updates the condition before checking the flag:
+     * with sequentially consistent accesses, at least one of them is
+     * guaranteed to observe the other and the wake up can not be missed.
+     */
+    pthread_mutex_lock(&s->lock);
+    ngli_atomic_store(&w->parked, 1);
+    while (!check(s, arg))
+        pthread_cond_wait(&w->cond, &s->lock);
+    ngli_atomic_store(&w->parked, 0);
+    pthread_mutex_unlock(&s->lock);
+
+    w->nb_spins = NGLI_MAX(w->nb_spins / 2, s->min_spins);
+}
+
+static void wake(struct cmdring *s, struct waiter *w)
+{
+    if (!ngli_atomic_load(&w->parked))
+        return;
+    pthread_mutex_lock(&s->lock);
+    pthread_cond_signal(&w->cond);
+    pthread_mutex_unlock(&s->lock);
+}
+
+struct cmdring *ngli_cmdring_create(int nb_elems, size_t elem_size)
+{
+    ngli_assert(nb_elems > 1 && !(nb_elems & (nb_elems - 1)));
+
+    struct cmdring *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->elems = ngli_calloc(nb_elems, elem_size);
+    s->completions = ngli_calloc(nb_elems, sizeof(*s->completions));
+    if (!s->elems || !s->completions ||
+        pthread_mutex_init(&s->lock, NULL) ||
+        pthread_cond_init(&s->producer.cond, NULL) ||
+        pthread_cond_init(&s->consumer.cond, NULL)) {
+        pthread_cond_destroy(&s->producer.cond);
+        pthread_cond_destroy(&s->consumer.cond);
+        pthread_mutex_destroy(&s->lock);
+        ngli_free(s->elems);
+        ngli_free(s->completions);
+        ngli_free(s);
+        return NULL;
+    }
+
+    /*
+     * Spinning is pointless if the other side can not run at the same time:
+     * it would only delay the moment the waiting thread yields the CPU
+     */
+    if (ngli_get_nb_cpus() > 1) {
+        s->min_spins = MIN_SPINS;
+        s->max_spins = MAX_SPINS;
+    }
+
+    s->elem_size = elem_size;
+    s->mask = nb_elems - 1;
+    s->producer.nb_spins = s->min_spins;
+    s->consumer.nb_spins = s->min_spins;
+    return s;
+}
+
+void ngli_cmdring_push(struct cmdring *s, const void *elem, struct cmdring_completion *completion)
+{
+    wait_for(s, &s->producer, has_free_slot, NULL);
+
+    const int tail = s->tail;
+    memcpy(s->elems + tail * s->elem_size, elem, s->elem_size);
+    s->completions[tail] = completion;
+    if (completion)
+        ngli_atomic_store(&completion->done, 0);
+    ngli_atomic_store(&s->tail, (tail + 1) & s->mask);
+
+    wake(s, &s->consumer);
+}
+
+int ngli_cmdring_poll(struct cmdring *s, struct cmdring_completion *completion)
+{
+    return is_completed(s, completion);
+}
+
+int ngli_cmdring_wait(struct cmdring *s, struct cmdring_completion *completion)
+{
+    wait_for(s, &s->producer, is_completed, completion);
+    return completion->ret;
+}
+
+void ngli_cmdring_pop(struct cmdring *s, void *elem, struct cmdring_completion **completionp)
+{
+    wait_for(s, &s->consumer, has_pending_elem, NULL);
+
+    const int head = s->head;
+    memcpy(elem, s->elems + head * s->elem_size, s->elem_size);
+    *completionp = s->completions[head];
+    ngli_atomic_store(&s->head, (head + 1) & s->mask);
+
+    /* The producer may be waiting for a free slot */
+    wake(s, &s->producer);
+}
+
+void ngli_cmdring_complete(struct cmdring *s, struct cmdring_completion *completion, int ret)
+{
+    if (!completion)
+        return;
+
+    /* The completion may be released by the producer as soon as done is set */
+    completion->ret = ret;
+    ngli_atomic_store(&completion->done, 1);
+
+    wake(s, &s->producer);
+}
+
+void ngli_cmdring_freep(struct cmdring **sp)
+{
+    struct cmdring *s = *sp;
+    if (!s)
+        return;
+    pthread_cond_destroy(&s->consumer.cond);
+    pthread_cond_destroy(&s->producer.cond);
+    pthread_mutex_destroy(&s->lock);
+    ngli_free(s->elems);
+    ngli_free(s->completions);
+    ngli_freep(sp);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CMDRING_H
+#define CMDRING_H
+
+#include <stddef.h>
+
+/*
+ * Lock-free single-producer/single-consumer ring of fixed-size commands.
+ *
+ * Waiting (for a free slot, a command or a completion) first spins for an
+ * adaptive amount of iterations before parking the thread on a condition
+ * variable: the spin budget grows when the waits are short and shrinks when
+ * the thread ends up parked anyway.
+ */
+
+struct cmdring;
+
+/*
+ * Per-command completion slot, owned by the producer. It must remain valid
+ * until ngli_cmdring_wait() returns.
+ */
+struct cmdring_completion {
+    int done;
+    int ret;
+};
+
+/* nb_elems must be a power of two; one slot is always kept unused */
+struct cmdring *ngli_cmdring_create(int nb_elems, size_t elem_size);
+
+/* Producer side */
+void ngli_cmdring_push(struct cmdring *s, const void *elem, struct cmdring_completion *completion);
+int ngli_cmdring_poll(struct cmdring *s, struct cmdring_completion *completion);
+int ngli_cmdring_wait(struct cmdring *s, struct cmdring_completion *completion);
+
+/* Consumer side */
+void ngli_cmdring_pop(struct cmdring *s, void *elem, struct cmdring_completion **completionp);
+void ngli_cmdring_complete(struct cmdring *s, struct cmdring_completion *completion, int ret);
+
+void ngli_cmdring_freep(struct cmdring **sp);
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "darray.h"
+#include "drawlist.h"
+#include "log.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "nodes.h"
+#include "utils.h"
+
+/*
+ * A record either draws a node (node != NULL) or is a branch skipping the
+ * nb_records following records when *cond is 0.
+ */
+struct record {
+    struct ngl_node *node;
+    struct rnode *rnode;
+    int matrix_index;
+    const int *cond;
+    int nb_records;
+};
+
+struct matrix_entry {
+    int parent;
+    const float *matrix;
+};
+
+struct drawlist {
+    struct ngl_ctx *ctx;
+    struct darray records;          // record
+    struct darray matrix_entries;   // matrix_entry
+    struct darray matrices;         // evaluated model-view matrices
+    int matrix_index;               // current matrix during the compilation, -1 for the root
+};
+
+struct drawlist *ngli_drawlist_create(struct ngl_ctx *ctx)
+{
+    struct drawlist *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+    s->ctx = ctx;
+    s->matrix_index = -1;
+    ngli_darray_init(&s->records, sizeof(struct record), 0);
+    ngli_darray_init(&s->matrix_entries, sizeof(struct matrix_entry), 0);
+    ngli_darray_init(&s->matrices, 4 * 4 * sizeof(float), 1);
+    return s;
+}
+
+int ngli_drawlist_add_draw(struct drawlist *s, struct ngl_node *node)
+{
+    const struct record record = {
+        .node = node,
+        .rnode = s->ctx->rnode_pos,
+        .matrix_index = s->matrix_index,
+    };
+    if (!ngli_darray_push(&s->records, &record))
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+int ngli_drawlist_add_node(struct drawlist *s, struct ngl_node *node)
+{
+    if (node->cls->compile)
+        return node->cls->compile(node, s);
+    if (node->cls->draw)
+        return ngli_drawlist_add_draw(s, node);
+    return 0;
+}
+
+int ngli_drawlist_push_matrix(struct drawlist *s, const float *matrix)
+{
+    const struct matrix_entry entry = {
+        .parent = s->matrix_index,
+        .matrix = matrix,
+    };
+    if (!ngli_darray_push(&s->matrix_entries, &entry) ||
+        !ngli_darray_push(&s->matrices, NULL))
+        return NGL_ERROR_MEMORY;
+    s->matrix_index = ngli_darray_count(&s->matrix_entries) - 1;
+    return 0;
+}
+
+void ngli_drawlist_pop_matrix(struct drawlist *s)
+{
+    const struct matrix_entry *entries = ngli_darray_data(&s->matrix_entries);
+    ngli_assert(s->matrix_index >= 0);
+    s->matrix_index = entries[s->matrix_index].parent;
+}
+
+int ngli_drawlist_begin_branch(struct drawlist *s, const int *cond)
+{
+    const struct record record = {.cond = cond};
+    if (!ngli_darray_push(&s->records, &record))
+        return NGL_ERROR_MEMORY;
+    return ngli_darray_count(&s->records) - 1;
+}
+
+void ngli_drawlist_end_branch(struct drawlist *s, int branch)
+{
+    struct record *records = ngli_darray_data(&s->records);
+    records[branch].nb_records = ngli_darray_count(&s->records) - branch - 1;
+}
+
+int ngli_drawlist_compile(struct drawlist *s, struct ngl_node *scene)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    ngli_darray_clear(&s->records);
+    ngli_darray_clear(&s->matrix_entries);
+    ngli_darray_clear(&s->matrices);
+    s->matrix_index = -1;
+
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    int ret = ngli_drawlist_add_node(s, scene);
+    ctx->rnode_pos = rnode_pos;
+    if (ret < 0)
+        return ret;
+
+    ngli_assert(s->matrix_index == -1);
+    LOG(DEBUG, "scene %s compiled into %d records and %d matrices", scene->label,
+        ngli_darray_count(&s->records), ngli_darray_count(&s->matrix_entries));
+    return 0;
+}
+
+int ngli_drawlist_exec(struct drawlist *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    NGLI_ALIGNED_MAT(root_matrix);
+    memcpy(root_matrix, ngli_darray_tail(&ctx->modelview_matrix_stack), sizeof(root_matrix));
+
+    const struct matrix_entry *entries = ngli_darray_data(&s->matrix_entries);
+    float *matrices = ngli_darray_data(&s->matrices);
+
+    /* The parent entries are always located before their children */
+    for (int i = 0; i < ngli_darray_count(&s->matrix_entries); i++) {
+        const struct matrix_entry *entry = &entries[i];
+        const float *parent = entry->parent < 0 ? root_matrix : &matrices[entry->parent * 4 * 4];
+        ngli_mat4_mul(&matrices[i * 4 * 4], parent, entry->matrix);
+    }
+
+    /*
+     * The matrix of each record is written in a dedicated slot on top of the
+     * stack, which is what the nodes would observe with the recursive
+     * traversal.
+     */
+    if (!ngli_darray_push(&ctx->modelview_matrix_stack, root_matrix))
+        return NGL_ERROR_MEMORY;
+
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    const struct record *records = ngli_darray_data(&s->records);
+    const int nb_records = ngli_darray_count(&s->records);
+    for (int i = 0; i < nb_records; i++) {
+        const struct record *record = &records[i];
+        if (!record->node) {
+            if (!*record->cond)
+                i += record->nb_records;
+            continue;
+        }
+
+        /*
+         * The tail is fetched again for every record because the nodes
+         * drawn may push matrices and thus reallocate the stack.
+         */
+        const int matrix_index = record->matrix_index;
+        const float *matrix = matrix_index < 0 ? root_matrix : &matrices[matrix_index * 4 * 4];
+        memcpy(ngli_darray_tail(&ctx->modelview_matrix_stack), matrix, sizeof(root_matrix));
+        ctx->rnode_pos = record->rnode;
+        ngli_node_draw(record->node);
+    }
+    ctx->rnode_pos = rnode_pos;
+
+    ngli_darray_pop(&ctx->modelview_matrix_stack);
+    return 0;
+}
+
+void ngli_drawlist_freep(struct drawlist **sp)
+{
+    struct drawlist *s = *sp;
+    if (!s)
+        return;
+    ngli_darray_reset(&s->records);
+    ngli_darray_reset(&s->matrix_entries);
+    ngli_darray_reset(&s->matrices);
+    ngli_freep(sp);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include "nodes.h"
+
+/*
+ * A draw list is the scene graph flattened into a linear sequence of draw
+ * records, each of them referencing a node to draw along with its render
+ * node and an entry in a table of model-view matrices. Executing the list
+ * replaces the recursive ngli_node_draw() traversal of the scene: the
+ * matrices are first evaluated in one pass, then the records are replayed
+ * in order.
+ *
+ * The list is built by the compile() callback of the node classes; a node
+ * without such callback is recorded as a whole and drawn with
+ * ngli_node_draw(), which is always a valid fallback.
+ */
+struct drawlist;
+
+struct drawlist *ngli_drawlist_create(struct ngl_ctx *ctx);
+int ngli_drawlist_compile(struct drawlist *s, struct ngl_node *scene);
+int ngli_drawlist_exec(struct drawlist *s);
+void ngli_drawlist_freep(struct drawlist **sp);
+
+/* Helpers for the compile() callbacks */
+int ngli_drawlist_add_node(struct drawlist *s, struct ngl_node *node);
+int ngli_drawlist_add_draw(struct drawlist *s, struct ngl_node *node);
+int ngli_drawlist_push_matrix(struct drawlist *s, const float *matrix);
+void ngli_drawlist_pop_matrix(struct drawlist *s);
+
+/*
+ * The records added between ngli_drawlist_begin_branch() and
+ * ngli_drawlist_end_branch() are skipped during the execution if the value
+ * pointed by cond is 0 at that time.
+ */
+int ngli_drawlist_begin_branch(struct drawlist *s, const int *cond);
+void ngli_drawlist_end_branch(struct drawlist *s, int branch);
+
+#endif
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "easing_lut.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "utils.h"
+
+#define MIN_INTERVALS 16
+#define MAX_INTERVALS (1 << 14)
+#define NB_CHECKS     8
+
+static int check_error(const struct easing_lut *s, ngli_easing_lut_func_type func, const void *arg,
+                       double max_error)
+{
+    const int n = s->nb_intervals;
+    for (int i = 0; i < n; i++) {
+        for (int k = 1; k < NB_CHECKS; k++) {
+            const double t = (i + k / (double)NB_CHECKS) / n;
+            const double err = fabs(func(arg, t) - ngli_easing_lut_evaluate(s, t));
+            if (!(err <= max_error))
+                return 0;
+        }
+    }
+    return 1;
+}
+
+int ngli_easing_lut_init(struct easing_lut *s, ngli_easing_lut_func_type func, const void *arg,
+                         double max_error)
+{
+    memset(s, 0, sizeof(*s));
+
+    if (max_error <= 0.0)
+        return NGL_ERROR_INVALID_ARG;
+
+    for (int n = MIN_INTERVALS; n <= MAX_INTERVALS; n *= 2) {
+        double *values = ngli_realloc(s->values, (n + 1) * sizeof(*values));
+        if (!values) {
+            ngli_easing_lut_reset(s);
+            return NGL_ERROR_MEMORY;
+        }
+        for (int i = 0; i <= n; i++)
+            values[i] = func(arg, i / (double)n);
+        s->values = values;
+        s->nb_intervals = n;
+        if (check_error(s, func, arg, max_error))
+            return 0;
+    }
+
+    ngli_easing_lut_reset(s);
+    return NGL_ERROR_LIMIT_EXCEEDED;
+}
+
+double ngli_easing_lut_evaluate(const struct easing_lut *s, double t)
+{
+    const int n = s->nb_intervals;
+    const double x = NGLI_MIN(NGLI_MAX(t, 0.0), 1.0) * n;
+    const int i = NGLI_MIN((int)x, n - 1);
+    return NGLI_MIX(s->values[i], s->values[i + 1], x - i);
+}
+
+void ngli_easing_lut_reset(struct easing_lut *s)
+{
+    ngli_freep(&s->values);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef EASING_LUT_H
+#define EASING_LUT_H
+
+typedef double (*ngli_easing_lut_func_type)(const void *arg, double t);
+
+/*
+ * Piecewise linear approximation of a function over [0,1], sampled at
+ * regular intervals. The number of intervals is the smallest power of two
+ * for which the deviation from the function, measured at several points
+ * within each interval, stays below the requested maximum error.
+ */
+struct easing_lut {
+    double *values;
+    int nb_intervals;
+};
+
+int ngli_easing_lut_init(struct easing_lut *s, ngli_easing_lut_func_type func, const void *arg,
+                         double max_error);
+double ngli_easing_lut_evaluate(const struct easing_lut *s, double t);
+void ngli_easing_lut_reset(struct easing_lut *s);
+
+#endif
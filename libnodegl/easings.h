@@ -0,0 +1,80 @@
+/*
+ * Copyright 2016 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef EASINGS_H
+#define EASINGS_H
+
+enum easing_id {
+    EASING_LINEAR,
+    EASING_QUADRATIC_IN,
+    EASING_QUADRATIC_OUT,
+    EASING_QUADRATIC_IN_OUT,
+    EASING_QUADRATIC_OUT_IN,
+    EASING_CUBIC_IN,
+    EASING_CUBIC_OUT,
+    EASING_CUBIC_IN_OUT,
+    EASING_CUBIC_OUT_IN,
+    EASING_QUARTIC_IN,
+    EASING_QUARTIC_OUT,
+    EASING_QUARTIC_IN_OUT,
+    EASING_QUARTIC_OUT_IN,
+    EASING_QUINTIC_IN,
+    EASING_QUINTIC_OUT,
+    EASING_QUINTIC_IN_OUT,
+    EASING_QUINTIC_OUT_IN,
+    EASING_POWER_IN,
+    EASING_POWER_OUT,
+    EASING_POWER_IN_OUT,
+    EASING_POWER_OUT_IN,
+    EASING_SINUS_IN,
+    EASING_SINUS_OUT,
+    EASING_SINUS_IN_OUT,
+    EASING_SINUS_OUT_IN,
+    EASING_EXP_IN,
+    EASING_EXP_OUT,
+    EASING_EXP_IN_OUT,
+    EASING_EXP_OUT_IN,
+    EASING_CIRCULAR_IN,
+    EASING_CIRCULAR_OUT,
+    EASING_CIRCULAR_IN_OUT,
+    EASING_CIRCULAR_OUT_IN,
+    EASING_BOUNCE_IN,
+    EASING_BOUNCE_OUT,
+    EASING_ELASTIC_IN,
+    EASING_ELASTIC_OUT,
+    EASING_BACK_IN,
+    EASING_BACK_OUT,
+    EASING_BACK_IN_OUT,
+    EASING_BACK_OUT_IN,
+};
+
+typedef double easing_type;
+typedef easing_type (*easing_function)(easing_type, int, const easing_type *);
+
+struct easing {
+    easing_function function;
+    easing_function derivative;
+    easing_function resolution; /* NULL if the easing can not be solved */
+};
+
+const struct easing *ngli_easing_get(enum easing_id id);
+
+#endif
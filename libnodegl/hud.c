@@ -74,6 +74,10 @@ struct hud {
 #define MEMORY_WIDGET_TEXT_LEN      25
 #define ACTIVITY_WIDGET_TEXT_LEN    12
 #define DRAWCALL_WIDGET_TEXT_LEN    12
+#define UPLOAD_WIDGET_TEXT_LEN      12
+
+/* Largest memory size: UINT64_MAX in G (11 digits) followed by the unit */
+#define MEMORY_SIZE_TEXT_LEN 12
 
 enum {
     LATENCY_UPDATE_CPU,
@@ -240,6 +244,7 @@ enum widget_type {
     WIDGET_MEMORY,
     WIDGET_ACTIVITY,
     WIDGET_DRAWCALL,
+    WIDGET_UPLOAD,
 };
 
 struct data_graph {
@@ -279,6 +284,10 @@ struct widget_drawcall {
     int nb_draws;
 };
 
+struct widget_upload {
+    int64_t size;
+};
+
 struct widget {
     enum widget_type type;
     struct rect rect;
@@ -410,6 +419,11 @@ static int widget_drawcall_init(struct hud *s, struct widget *widget)
     return make_nodes_set(scene, &priv->nodes, node_types);
 }
 
+static int widget_upload_init(struct hud *s, struct widget *widget)
+{
+    return 0;
+}
+
 /* Widget update */
 
 static void register_time(struct hud *s, struct latency_measure *m, int64_t t)
@@ -504,6 +518,13 @@ static void widget_drawcall_make_stats(struct hud *s, struct widget *widget)
         priv->nb_draws += nodes[i]->draw_count;
 }
 
+static void widget_upload_make_stats(struct hud *s, struct widget *widget)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct widget_upload *priv = widget->priv_data;
+    priv->size = ctx->upload_size;
+}
+
 /* Draw utils */
 
 static inline uint8_t *set_color(uint8_t *p, uint32_t rgba)
@@ -661,24 +682,31 @@ static void widget_latency_draw(struct hud *s, struct widget *widget)
     }
 }
 
+static void format_size(char *buf, size_t len, uint64_t size)
+{
+    if (size < 1024)
+        snprintf(buf, len, "%"PRIu64, size);
+    else if (size < 1024 * 1024)
+        snprintf(buf, len, "%"PRIu64"K", size / 1024);
+    else if (size < 1024 * 1024 * 1024)
+        snprintf(buf, len, "%"PRIu64"M", size / (1024 * 1024));
+    else
+        snprintf(buf, len, "%"PRIu64"G", size / (1024 * 1024 * 1024));
+}
+
 static void widget_memory_draw(struct hud *s, struct widget *widget)
 {
     struct widget_memory *priv = widget->priv_data;
     char buf[MEMORY_WIDGET_TEXT_LEN + 1];
+    char size_buf[MEMORY_SIZE_TEXT_LEN + 1];
 
     for (int i = 0; i < NB_MEMORY; i++) {
         const uint64_t size = priv->sizes[i];
         const uint32_t color = memory_specs[i].color;
         const char *label = memory_specs[i].label;
 
-        if (size < 1024)
-            snprintf(buf, sizeof(buf), "%-12s %"PRIu64, label, size);
-        else if (size < 1024 * 1024)
-            snprintf(buf, sizeof(buf), "%-12s %"PRIu64"K", label, size / 1024);
-        else if (size < 1024 * 1024 * 1024)
-            snprintf(buf, sizeof(buf), "%-12s %"PRIu64"M", label, size / (1024 * 1024));
-        else
-            snprintf(buf, sizeof(buf), "%-12s %"PRIu64"G", label, size / (1024 * 1024 * 1024));
+        format_size(size_buf, sizeof(size_buf), size);
+        snprintf(buf, sizeof(buf), "%-12s %s", label, size_buf);
         print_text(s, widget->text_x, widget->text_y + i * NGLI_FONT_H, buf, color);
         register_graph_value(&widget->data_graph[i], size);
     }
@@ -730,6 +758,21 @@ static void widget_drawcall_draw(struct hud *s, struct widget *widget)
     draw_block_graph(s, d, &widget->graph_rect, d->amin, d->amax, color);
 }
 
+static void widget_upload_draw(struct hud *s, struct widget *widget)
+{
+    struct widget_upload *priv = widget->priv_data;
+    const uint32_t color = 0xF4A63DFF;
+
+    char buf[UPLOAD_WIDGET_TEXT_LEN + 1];
+    format_size(buf, sizeof(buf), priv->size);
+    print_text(s, widget->text_x, widget->text_y, "Uploads", color);
+    print_text(s, widget->text_x, widget->text_y + NGLI_FONT_H, buf, color);
+
+    struct data_graph *d = &widget->data_graph[0];
+    register_graph_value(d, priv->size);
+    draw_block_graph(s, d, &widget->graph_rect, d->amin, d->amax, color);
+}
+
 /* Widget CSV header */
 
 static void widget_latency_csv_header(struct hud *s, struct widget *widget, struct bstr *dst)
@@ -756,6 +799,11 @@ static void widget_drawcall_csv_header(struct hud *s, struct widget *widget, str
     ngli_bstr_print(dst, spec->label);
 }
 
+static void widget_upload_csv_header(struct hud *s, struct widget *widget, struct bstr *dst)
+{
+    ngli_bstr_print(dst, "Uploads");
+}
+
 /* Widget CSV report */
 
 static void widget_latency_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
@@ -788,6 +836,12 @@ static void widget_drawcall_csv_report(struct hud *s, struct widget *widget, str
     ngli_bstr_printf(dst, "%d", priv->nb_draws);
 }
 
+static void widget_upload_csv_report(struct hud *s, struct widget *widget, struct bstr *dst)
+{
+    const struct widget_upload *priv = widget->priv_data;
+    ngli_bstr_printf(dst, "%"PRId64, priv->size);
+}
+
 /* Widget uninit */
 
 static void widget_latency_uninit(struct hud *s, struct widget *widget)
@@ -816,6 +870,10 @@ static void widget_drawcall_uninit(struct hud *s, struct widget *widget)
     ngli_darray_reset(&priv->nodes);
 }
 
+static void widget_upload_uninit(struct hud *s, struct widget *widget)
+{
+}
+
 static const struct widget_spec widget_specs[] = {
     [WIDGET_LATENCY] = {
         .text_cols     = LATENCY_WIDGET_TEXT_LEN,
@@ -869,6 +927,19 @@ static const struct widget_spec widget_specs[] = {
         .csv_report    = widget_drawcall_csv_report,
         .uninit        = widget_drawcall_uninit,
     },
+    [WIDGET_UPLOAD]  = {
+        .text_cols     = UPLOAD_WIDGET_TEXT_LEN,
+        .text_rows     = 2,
+        .graph_h       = 40,
+        .nb_data_graph = 1,
+        .priv_size     = sizeof(struct widget_upload),
+        .init          = widget_upload_init,
+        .make_stats    = widget_upload_make_stats,
+        .draw          = widget_upload_draw,
+        .csv_header    = widget_upload_csv_header,
+        .csv_report    = widget_upload_csv_report,
+        .uninit        = widget_upload_uninit,
+    },
 };
 
 static inline int get_widget_width(enum widget_type type)
@@ -956,7 +1027,8 @@ static int widgets_init(struct hud *s)
     const int latency_width  = get_widget_width(WIDGET_LATENCY);
     const int memory_width   = get_widget_width(WIDGET_MEMORY);
     const int activity_width = get_widget_width(WIDGET_ACTIVITY) * NB_ACTIVITY + WIDGET_MARGIN * (NB_ACTIVITY - 1);
-    const int drawcall_width = get_widget_width(WIDGET_DRAWCALL) * NB_DRAWCALL + WIDGET_MARGIN * (NB_DRAWCALL - 1);
+    const int drawcall_width = get_widget_width(WIDGET_DRAWCALL) * NB_DRAWCALL + WIDGET_MARGIN * NB_DRAWCALL
+                             + get_widget_width(WIDGET_UPLOAD);
 
     s->canvas.w = WIDGET_MARGIN * 2
                 + NGLI_MAX(NGLI_MAX(NGLI_MAX(latency_width, memory_width), activity_width), drawcall_width);
@@ -1003,6 +1075,11 @@ static int widgets_init(struct hud *s)
         x_drawcall += x_drawcall_step;
     }
 
+    /* Uploads widget at the end of the draw-calls row */
+    ret = create_widget(s, WIDGET_UPLOAD, NULL, x_drawcall, y_drawcall);
+    if (ret < 0)
+        return ret;
+
     /* Call init on every widget */
     struct darray *widgets_array = &s->widgets;
     struct widget *widgets = ngli_darray_data(widgets_array);
@@ -0,0 +1,240 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <float.h>
+#include <stdlib.h>
+
+#include "darray.h"
+#include "log.h"
+#include "lookahead.h"
+#include "memory.h"
+#include "nodes.h"
+#include "utils.h"
+
+#define DEFAULT_BUDGET 2000 /* in microseconds */
+
+struct entry {
+    struct ngl_node *trf;
+    int parent;             /* index of the enclosing TimeRangeFilter entry, -1 if none */
+    struct darray nodes;    /* prefetchable nodes of the child, up to the nested TimeRangeFilters */
+    double next_use;        /* seconds, evaluated for the current frame */
+};
+
+struct early_node {
+    struct ngl_node *node;
+    int entry;
+};
+
+struct lookahead {
+    struct ngl_ctx *ctx;
+    double window;
+    int64_t budget;
+    struct darray entries;      // entry
+    struct darray candidates;   // entry pointer
+    struct darray early_nodes;  // early_node
+};
+
+struct lookahead *ngli_lookahead_create(struct ngl_ctx *ctx)
+{
+    struct lookahead *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    const struct ngl_config *config = &ctx->config;
+    s->ctx = ctx;
+    s->window = config->lookahead_time;
+    s->budget = config->lookahead_budget ? config->lookahead_budget : DEFAULT_BUDGET;
+    ngli_darray_init(&s->entries, sizeof(struct entry), 0);
+    ngli_darray_init(&s->candidates, sizeof(struct entry *), 0);
+    ngli_darray_init(&s->early_nodes, sizeof(struct early_node), 0);
+    return s;
+}
+
+static void reset_entries(struct lookahead *s)
+{
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++)
+        ngli_darray_reset(&entries[i].nodes);
+    ngli_darray_clear(&s->entries);
+}
+
+/*
+ * The nodes are listed in post-order (children first), similarly to the order
+ * honored by ngli_node_honor_release_prefetch().
+ */
+static int collect_nodes(struct lookahead *s, struct ngl_node *node, int parent)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (node->visit_epoch == ctx->visit_epoch)
+        return 0;
+    node->visit_epoch = ctx->visit_epoch;
+
+    if (node->cls->id == NGL_NODE_TIMERANGEFILTER) {
+        struct entry *entry = ngli_darray_push(&s->entries, NULL);
+        if (!entry)
+            return NGL_ERROR_MEMORY;
+        entry->trf = node;
+        entry->parent = parent;
+        ngli_darray_init(&entry->nodes, sizeof(struct ngl_node *), 0);
+        parent = ngli_darray_count(&s->entries) - 1;
+    }
+
+    struct darray *children_array = &node->children;
+    struct ngl_node **children = ngli_darray_data(children_array);
+    for (int i = 0; i < ngli_darray_count(children_array); i++) {
+        int ret = collect_nodes(s, children[i], parent);
+        if (ret < 0)
+            return ret;
+    }
+
+    if (parent >= 0 && node->cls->prefetch) {
+        /* The entries may have been reallocated by the nested filters */
+        struct entry *entry = ngli_darray_get(&s->entries, parent);
+        if (!ngli_darray_push(&entry->nodes, &node))
+            return NGL_ERROR_MEMORY;
+    }
+
+    return 0;
+}
+
+int ngli_lookahead_init(struct lookahead *s, struct ngl_node *scene)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    reset_entries(s);
+    ngli_darray_clear(&s->early_nodes);
+
+    /*
+     * The visit epoch is borrowed to walk each node only once: the next visit
+     * increments it again so it is not affected.
+     */
+    ctx->visit_epoch++;
+    int ret = collect_nodes(s, scene, -1);
+    if (ret < 0)
+        return ret;
+
+    LOG(DEBUG, "look-ahead prefetch over %d time range filters",
+        ngli_darray_count(&s->entries));
+    return 0;
+}
+
+static int compare_next_use(const void *a, const void *b)
+{
+    const struct entry *e0 = *(const struct entry **)a;
+    const struct entry *e1 = *(const struct entry **)b;
+    return (e0->next_use > e1->next_use) - (e0->next_use < e1->next_use);
+}
+
+static void release_unneeded(struct lookahead *s)
+{
+    const struct entry *entries = ngli_darray_data(&s->entries);
+    struct early_node *early_nodes = ngli_darray_data(&s->early_nodes);
+    int nb_early_nodes = 0;
+    for (int i = 0; i < ngli_darray_count(&s->early_nodes); i++) {
+        struct early_node *early = &early_nodes[i];
+
+        /* Now handled by the regular visit */
+        if (early->node->is_active)
+            continue;
+
+        if (entries[early->entry].next_use > s->window) {
+            TRACE("%s not needed soon anymore, release it", early->node->label);
+            ngli_node_release(early->node);
+            continue;
+        }
+
+        early_nodes[nb_early_nodes++] = *early;
+    }
+    while (ngli_darray_count(&s->early_nodes) > nb_early_nodes)
+        ngli_darray_pop(&s->early_nodes);
+}
+
+int ngli_lookahead_run(struct lookahead *s, double t)
+{
+    const int64_t start_time = ngli_gettime_relative();
+
+    /* The entries are ordered such that the parents are evaluated first */
+    ngli_darray_clear(&s->candidates);
+    struct entry *entries = ngli_darray_data(&s->entries);
+    for (int i = 0; i < ngli_darray_count(&s->entries); i++) {
+        struct entry *entry = &entries[i];
+        const double parent_next_use = entry->parent < 0 ? 0. : entries[entry->parent].next_use;
+        if (parent_next_use > s->window) {
+            entry->next_use = DBL_MAX;
+            continue;
+        }
+        const double next_use = ngli_timerangefilter_get_next_use(entry->trf, t);
+        entry->next_use = NGLI_MAX(next_use, parent_next_use);
+        if (entry->next_use > 0. && entry->next_use <= s->window &&
+            !ngli_darray_push(&s->candidates, &entry))
+            return NGL_ERROR_MEMORY;
+    }
+
+    release_unneeded(s);
+
+    struct entry **candidates = ngli_darray_data(&s->candidates);
+    const int nb_candidates = ngli_darray_count(&s->candidates);
+    qsort(candidates, nb_candidates, sizeof(*candidates), compare_next_use);
+
+    int nb_prefetched = 0;
+    for (int i = 0; i < nb_candidates; i++) {
+        const struct entry *entry = candidates[i];
+        struct ngl_node **nodes = ngli_darray_data(&entry->nodes);
+        for (int j = 0; j < ngli_darray_count(&entry->nodes); j++) {
+            struct ngl_node *node = nodes[j];
+            if (node->is_active || !ngli_node_needs_prefetch(node))
+                continue;
+
+            /* At least one prefetch per frame, even if it exceeds the budget */
+            if (nb_prefetched && ngli_gettime_relative() - start_time >= s->budget)
+                return 0;
+            nb_prefetched++;
+
+            TRACE("prefetch %s, needed in %g", node->label, entry->next_use);
+
+            /*
+             * A failure is not fatal here: the node is prefetched again (and
+             * the error reported) when it is actually needed.
+             */
+            if (ngli_node_prefetch(node) < 0)
+                continue;
+
+            const struct early_node early = {.node = node, .entry = entry - entries};
+            if (!ngli_darray_push(&s->early_nodes, &early))
+                return NGL_ERROR_MEMORY;
+        }
+    }
+
+    return 0;
+}
+
+void ngli_lookahead_freep(struct lookahead **sp)
+{
+    struct lookahead *s = *sp;
+    if (!s)
+        return;
+    reset_entries(s);
+    ngli_darray_reset(&s->entries);
+    ngli_darray_reset(&s->candidates);
+    ngli_darray_reset(&s->early_nodes);
+    ngli_freep(sp);
+}
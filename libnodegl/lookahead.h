@@ -0,0 +1,43 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef LOOKAHEAD_H
+#define LOOKAHEAD_H
+
+struct ngl_ctx;
+struct ngl_node;
+
+/*
+ * Scene-level prefetch scheduler: it predicts from the TimeRangeFilter ranges
+ * which subtrees are going to be needed within the next lookahead_time
+ * seconds, and prefetches them in advance, within a time budget per frame and
+ * by order of upcoming use. The nodes prefetched that way are released if
+ * they end up not being needed within the window anymore (after a seek for
+ * example).
+ */
+struct lookahead;
+
+struct lookahead *ngli_lookahead_create(struct ngl_ctx *ctx);
+int ngli_lookahead_init(struct lookahead *s, struct ngl_node *scene);
+int ngli_lookahead_run(struct lookahead *s, double t);
+void ngli_lookahead_freep(struct lookahead **sp);
+
+#endif
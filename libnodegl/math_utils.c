@@ -251,7 +251,7 @@ void ngli_mat3_adjugate(float *dst, const float* m)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
-void ngli_mat3_inverse(float *dst, const float *m)
+void ngli_mat3_inverse_c(float *dst, const float *m)
 {
     float a[3*3];
     float det = ngli_mat3_determinant(m);
@@ -304,6 +304,13 @@ void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
+void ngli_mix_f32_c(float *dst, const float *x, const float *y, float a, int n)
+{
+    const float b = 1.f - a;
+    for (int i = 0; i < n; i++)
+        dst[i] = x[i] * b + y[i] * a;
+}
+
 void ngli_mat4_look_at(float *dst, float *eye, float *center, float *up)
 {
     float f[3];
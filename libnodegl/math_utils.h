@@ -76,7 +76,7 @@ void ngli_mat3_mul_scalar(float *dst, const float *m, float s);
 void ngli_mat3_transpose(float *dst, const float *m);
 float ngli_mat3_determinant(const float *m);
 void ngli_mat3_adjugate(float *dst, const float* m);
-void ngli_mat3_inverse(float *dst, const float *m);
+void ngli_mat3_inverse_c(float *dst, const float *m);
 
 #define NGLI_MAT4_IDENTITY {1.0f, 0.0f, 0.0f, 0.0f, \
                             0.0f, 1.0f, 0.0f, 0.0f, \
@@ -86,6 +86,11 @@ void ngli_mat3_inverse(float *dst, const float *m);
 void ngli_mat4_identity(float *dst);
 void ngli_mat4_mul_c(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v);
+
+/*
+ * Multiply the parent matrix by each of the n contiguous children matrices.
+ * dst may alias children but must not overlap with parent.
+ */
 void ngli_mat4_look_at(float *dst, float *eye, float *center, float *up);
 void ngli_mat4_orthographic(float *dst, float left, float right, float bottom, float top, float near, float far);
 void ngli_mat4_perspective(float *dst, float fov, float aspect, float near, float far);
@@ -95,18 +100,42 @@ void ngli_mat4_translate(float *dst, float x, float y, float z);
 void ngli_mat4_scale(float *dst, float x, float y, float z);
 void ngli_mat4_skew(float *dst, float x, float y, float z, const float *axis);
 
+void ngli_mix_f32_c(float *dst, const float *x, const float *y, float a, int n);
+
 /* Arch specific versions */
 
 #ifdef ARCH_AARCH64
+# define ngli_mat3_inverse      ngli_mat3_inverse_c
 # define ngli_mat4_mul          ngli_mat4_mul_aarch64
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_aarch64
+# define ngli_mix_f32           ngli_mix_f32_aarch64
+#elif defined(ARCH_X86_64)
+# define ngli_mat3_inverse      ngli_mat3_inverse_x86
+# define ngli_mat4_mul          ngli_mat4_mul_x86
+# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_x86
+# define ngli_mix_f32           ngli_mix_f32_x86
 #else
+# define ngli_mat3_inverse      ngli_mat3_inverse_c
 # define ngli_mat4_mul          ngli_mat4_mul_c
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_c
+# define ngli_mix_f32           ngli_mix_f32_c
 #endif
 
 void ngli_mat4_mul_aarch64(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
+void ngli_mix_f32_aarch64(float *dst, const float *x, const float *y, float a, int n);
+
+/*
+ * The x86 entry points use SSE2 (always available on x86-64) and switch at
+ * runtime to the AVX variants when the CPU supports them. The mat4 mul has no
+ * SSE2 variant since it is not faster than the C one.
+ */
+int ngli_x86_has_avx(void);
+void ngli_mat3_inverse_x86(float *dst, const float *m);
+void ngli_mat4_mul_x86(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_avx(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_vec4_x86(float *dst, const float *m, const float *v);
+void ngli_mix_f32_x86(float *dst, const float *x, const float *y, float a, int n);
 
 #define NGLI_QUAT_IDENTITY {0.0f, 0.0f, 0.0f, 1.0f}
 
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include <immintrin.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# include <intrin.h>
+#endif
+
+#include "math_utils.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+# define TARGET_AVX
+#else
+# define TARGET_AVX __attribute__((target("avx")))
+#endif
+
+int ngli_x86_has_avx(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static int has_avx = -1;
+    if (has_avx < 0) {
+        /* AVX must be supported by the CPU and its state saved by the OS */
+        int info[4];
+        __cpuid(info, 1);
+        const int osxsave_avx = 1 << 27 | 1 << 28;
+        has_avx = (info[2] & osxsave_avx) == osxsave_avx && (_xgetbv(0) & 0x6) == 0x6;
+    }
+    return has_avx;
+#else
+    return __builtin_cpu_supports("avx");
+#endif
+}
+
+static inline __m128 mat4_mul_col_sse2(__m128 m0, __m128 m1, __m128 m2, __m128 m3, __m128 v)
+{
+    const __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m1, y)),
+                      _mm_add_ps(_mm_mul_ps(m2, z), _mm_mul_ps(m3, w)));
+}
+
+/* Multiply m by the two columns packed in v, one per 128-bit lane */
+TARGET_AVX
+static inline __m256 mat4_mul_2cols_avx(__m256 m0, __m256 m1, __m256 m2, __m256 m3, __m256 v)
+{
+    const __m256 x = _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m256 y = _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m256 z = _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m256 w = _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m1, y)),
+                         _mm256_add_ps(_mm256_mul_ps(m2, z), _mm256_mul_ps(m3, w)));
+}
+
+TARGET_AVX
+void ngli_mat4_mul_avx(float *dst, const float *m1, const float *m2)
+{
+    const __m256 a0 = _mm256_broadcast_ps((const __m128 *)m1);
+    const __m256 a1 = _mm256_broadcast_ps((const __m128 *)(m1 + 4));
+    const __m256 a2 = _mm256_broadcast_ps((const __m128 *)(m1 + 8));
+    const __m256 a3 = _mm256_broadcast_ps((const __m128 *)(m1 + 12));
+    const __m256 b01 = _mm256_loadu_ps(m2);
+    const __m256 b23 = _mm256_loadu_ps(m2 + 8);
+    _mm256_storeu_ps(dst,     mat4_mul_2cols_avx(a0, a1, a2, a3, b01));
+    _mm256_storeu_ps(dst + 8, mat4_mul_2cols_avx(a0, a1, a2, a3, b23));
+}
+
+void ngli_mat4_mul_x86(float *dst, const float *m1, const float *m2)
+{
+    if (ngli_x86_has_avx())
+        ngli_mat4_mul_avx(dst, m1, m2);
+    else
+        ngli_mat4_mul_c(dst, m1, m2);
+}
+
+void ngli_mat4_mul_vec4_x86(float *dst, const float *m, const float *v)
+{
+    const __m128 m0 = _mm_loadu_ps(m);
+    const __m128 m1 = _mm_loadu_ps(m + 4);
+    const __m128 m2 = _mm_loadu_ps(m + 8);
+    const __m128 m3 = _mm_loadu_ps(m + 12);
+    _mm_storeu_ps(dst, mat4_mul_col_sse2(m0, m1, m2, m3, _mm_loadu_ps(v)));
+}
+
+/* a.yzx * b.zxy - a.zxy * b.yzx, the 4th component is ignored */
+static inline __m128 vec3_cross_sse2(__m128 a, __m128 b)
+{
+    const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+void ngli_mat3_inverse_x86(float *dst, const float *m)
+{
+    /*
+     * The 3 columns are loaded with 4-float loads not going past the end of
+     * the matrix, the extra components are never used in the results.
+     */
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 3);
+    const __m128 c2_tail = _mm_loadu_ps(m + 5);
+    const __m128 c2 = _mm_shuffle_ps(c2_tail, c2_tail, _MM_SHUFFLE(3, 3, 2, 1));
+
+    /* The rows of the inverse are the cross products of the columns over the determinant */
+    __m128 r0 = vec3_cross_sse2(c1, c2);
+    __m128 r1 = vec3_cross_sse2(c2, c0);
+    __m128 r2 = vec3_cross_sse2(c0, c1);
+
+    const __m128 d = _mm_mul_ps(c0, r0);
+    const float det = _mm_cvtss_f32(d)
+                    + _mm_cvtss_f32(_mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 1, 1, 1)))
+                    + _mm_cvtss_f32(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 2, 2, 2)));
+    if (det == 0.f) {
+        if (dst != m)
+            memcpy(dst, m, 3 * 3 * sizeof(*m));
+        return;
+    }
+
+    const __m128 inv_det = _mm_set1_ps((float)(1.0 / det));
+    r0 = _mm_mul_ps(r0, inv_det);
+    r1 = _mm_mul_ps(r1, inv_det);
+    r2 = _mm_mul_ps(r2, inv_det);
+
+    __m128 r3 = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    /* Overlapping stores, each column overwrites the padding of the previous one */
+    _mm_storeu_ps(dst, r0);
+    _mm_storeu_ps(dst + 3, r1);
+    _mm_storel_pi((__m64 *)(dst + 6), r2);
+    _mm_store_ss(dst + 8, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(2, 2, 2, 2)));
+}
+
+void ngli_mix_f32_x86(float *dst, const float *x, const float *y, float a, int n)
+{
+    const float b = 1.f - a;
+    const __m128 va = _mm_set1_ps(a);
+    const __m128 vb = _mm_set1_ps(b);
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m128 x0 = _mm_loadu_ps(x + i);
+        const __m128 x1 = _mm_loadu_ps(x + i + 4);
+        const __m128 y0 = _mm_loadu_ps(y + i);
+        const __m128 y1 = _mm_loadu_ps(y + i + 4);
+        _mm_storeu_ps(dst + i,     _mm_add_ps(_mm_mul_ps(x0, vb), _mm_mul_ps(y0, va)));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_mul_ps(x1, vb), _mm_mul_ps(y1, va)));
+    }
+    for (; i < n; i++)
+        dst[i] = x[i] * b + y[i] * a;
+}
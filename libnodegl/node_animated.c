@@ -111,7 +111,7 @@ static void mix_path(void *user_arg, void *dst,
 {
     const float t = NGLI_MIX(kf0->scalar, kf1->scalar, ratio);
     struct variable_priv *s = user_arg;
-    struct path *path = *(struct path **)s->path_node->priv_data;
+    const struct path *path = *(struct path **)s->path_node->priv_data;
     ngli_path_evaluate(path, dst, t);
 }
 
@@ -200,13 +200,25 @@ static ngli_animation_cpy_func_type get_cpy_func(int node_class)
     return NULL;
 }
 
-int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
+static int get_nb_comps(int node_class)
+{
+    switch (node_class) {
+        case NGL_NODE_ANIMATEDFLOAT: return 1;
+        case NGL_NODE_ANIMATEDVEC2:  return 2;
+        case NGL_NODE_ANIMATEDVEC3:  return 3;
+        case NGL_NODE_ANIMATEDVEC4:  return 4;
+        case NGL_NODE_ANIMATEDQUAT:  return 4;
+    }
+    return 0;
+}
+
+int ngl_anim_evaluate_array(struct ngl_node *node, void *dst, const double *t, int nb_values)
 {
     if (node->cls->id == NGL_NODE_VELOCITYFLOAT ||
         node->cls->id == NGL_NODE_VELOCITYVEC2 ||
         node->cls->id == NGL_NODE_VELOCITYVEC3 ||
         node->cls->id == NGL_NODE_VELOCITYVEC4)
-        return ngli_velocity_evaluate(node, dst, t);
+        return ngli_velocity_evaluate(node, dst, t, nb_values);
 
     if (node->cls->id != NGL_NODE_ANIMATEDFLOAT &&
         node->cls->id != NGL_NODE_ANIMATEDVEC2 &&
@@ -224,25 +236,50 @@ int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
         return NGL_ERROR_UNSUPPORTED;
     }
 
-    if (!s->anim_eval.kfs) {
+    /*
+     * The evaluation state is built on the first call (or after key frames
+     * were added) and then reused. The node is not necessarily attached to a
+     * context, so it is released when the node is deleted, if not at uninit.
+     * The key frame times are still refreshed on every call since they can be
+     * changed at any time by the user.
+     */
+    struct animkeyframe_priv *kf0 = s->animkf[0]->priv_data;
+    if (!kf0->function || s->anim_eval.nb_kfs != s->nb_animkf) {
+        for (int i = 0; i < s->nb_animkf; i++) {
+            const struct animkeyframe_priv *kf = s->animkf[i]->priv_data;
+            if (kf->function)
+                continue;
+            int ret = s->animkf[i]->cls->init(s->animkf[i]);
+            if (ret < 0)
+                return ret;
+        }
+
+        ngli_animation_reset(&s->anim_eval);
         int ret = ngli_animation_init(&s->anim_eval, s,
                                       s->animkf, s->nb_animkf,
                                       get_mix_func(node->cls->id),
                                       get_cpy_func(node->cls->id));
         if (ret < 0)
             return ret;
+    } else {
+        int ret = ngli_animation_refresh_times(&s->anim_eval);
+        if (ret < 0)
+            return ret;
     }
 
-    struct animkeyframe_priv *kf0 = s->animkf[0]->priv_data;
-    if (!kf0->function) {
-        for (int i = 0; i < s->nb_animkf; i++) {
-            int ret = s->animkf[i]->cls->init(s->animkf[i]);
-            if (ret < 0)
-                return ret;
-        }
+    float *values = dst;
+    const int nb_comps = get_nb_comps(node->cls->id);
+    for (int i = 0; i < nb_values; i++) {
+        int ret = ngli_animation_evaluate(&s->anim_eval, values + i * nb_comps, t[i]);
+        if (ret < 0)
+            return ret;
     }
+    return 0;
+}
 
-    return ngli_animation_evaluate(&s->anim_eval, dst, t);
+int ngl_anim_evaluate(struct ngl_node *node, void *dst, double t)
+{
+    return ngl_anim_evaluate_array(node, dst, &t, 1);
 }
 
 static int animation_init(struct ngl_node *node)
@@ -343,22 +380,38 @@ static int animatedquat_update(struct ngl_node *node, double t)
     return 0;
 }
 
-#define DEFINE_ANIMATED_CLASS(class_id, class_name, type)       \
+static void animation_uninit(struct ngl_node *node)
+{
+    struct variable_priv *s = node->priv_data;
+    ngli_animation_reset(&s->anim);
+    ngli_animation_reset(&s->anim_eval);
+}
+
+static void animation_free(struct ngl_node *node)
+{
+    struct variable_priv *s = node->priv_data;
+    ngli_animation_reset(&s->anim_eval);
+}
+
+#define DEFINE_ANIMATED_CLASS(class_id, class_name, type, class_flags) \
 const struct node_class ngli_animated##type##_class = {         \
     .id        = class_id,                                      \
     .category  = NGLI_NODE_CATEGORY_UNIFORM,                    \
+    .flags     = NGLI_NODE_FLAG_TIME_VARYING | class_flags,     \
     .name      = class_name,                                    \
     .init      = animated##type##_init,                         \
     .update    = animated##type##_update,                       \
+    .uninit    = animation_uninit,                              \
+    .free      = animation_free,                                \
     .priv_size = sizeof(struct variable_priv),                  \
     .params    = animated##type##_params,                       \
     .file      = __FILE__,                                      \
 };
 
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDTIME,  "AnimatedTime",  time)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDFLOAT, "AnimatedFloat", float)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC2,  "AnimatedVec2",  vec2)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC3,  "AnimatedVec3",  vec3)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC4,  "AnimatedVec4",  vec4)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDQUAT,  "AnimatedQuat",  quat)
-DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDPATH,  "AnimatedPath",  path)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDTIME,  "AnimatedTime",  time,  NGLI_NODE_FLAG_THREADSAFE_UPDATE)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDFLOAT, "AnimatedFloat", float, NGLI_NODE_FLAG_THREADSAFE_UPDATE)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC2,  "AnimatedVec2",  vec2,  NGLI_NODE_FLAG_THREADSAFE_UPDATE)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC3,  "AnimatedVec3",  vec3,  NGLI_NODE_FLAG_THREADSAFE_UPDATE)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDVEC4,  "AnimatedVec4",  vec4,  NGLI_NODE_FLAG_THREADSAFE_UPDATE)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDQUAT,  "AnimatedQuat",  quat,  NGLI_NODE_FLAG_THREADSAFE_UPDATE)
+DEFINE_ANIMATED_CLASS(NGL_NODE_ANIMATEDPATH,  "AnimatedPath",  path,  NGLI_NODE_FLAG_THREADSAFE_UPDATE)
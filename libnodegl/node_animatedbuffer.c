@@ -23,6 +23,7 @@
 #include <stddef.h>
 #include <string.h>
 #include "animation.h"
+#include "gpu_ctx.h"
 #include "log.h"
 #include "math_utils.h"
 #include "memory.h"
@@ -36,6 +37,9 @@ static const struct node_param animatedbuffer_params[] = {
                   .node_types=(const int[]){NGL_NODE_ANIMKEYFRAMEBUFFER, -1},
                   .flags=NGLI_PARAM_FLAG_DOT_DISPLAY_PACKED,
                   .desc=NGLI_DOCSTRING("key frame buffers to interpolate from")},
+    {"gpu_eval",  NGLI_PARAM_TYPE_BOOL, OFFSET(gpu_eval), {.i64=0},
+                  .desc=NGLI_DOCSTRING("interpolate the key frame buffers on the GPU, "
+                                       "in which case the buffer can not be used as a block field")},
     {NULL}
 };
 
@@ -44,13 +48,10 @@ static void mix_buffer(void *user_arg, void *dst,
                        const struct animkeyframe_priv *kf1,
                        double ratio)
 {
-    float *dstf = dst;
     const struct buffer_priv *s = user_arg;
     const float *d1 = (const float *)kf0->data;
     const float *d2 = (const float *)kf1->data;
-    for (int k = 0; k < s->count; k++)
-        for (int i = 0; i < s->data_comp; i++)
-            dstf[k*s->data_comp + i] = NGLI_MIX(d1[k*s->data_comp + i], d2[k*s->data_comp + i], ratio);
+    ngli_mix_f32(dst, d1, d2, ratio, s->count * s->data_comp);
 }
 
 static void cpy_buffer(void *user_arg, void *dst,
@@ -60,6 +61,56 @@ static void cpy_buffer(void *user_arg, void *dst,
     memcpy(dst, kf->data, s->data_size);
 }
 
+/*
+ * With the GPU evaluation, the update only selects the key frames to
+ * interpolate: the interpolation itself happens at upload time.
+ */
+static void mix_buffer_gpu(void *user_arg, void *dst,
+                           const struct animkeyframe_priv *kf0,
+                           const struct animkeyframe_priv *kf1,
+                           double ratio)
+{
+    struct buffer_priv *s = user_arg;
+    s->mix_kfs[0] = s->anim.current_kf;
+    s->mix_kfs[1] = s->anim.current_kf + 1;
+    s->mix_ratio = ratio;
+}
+
+static void cpy_buffer_gpu(void *user_arg, void *dst,
+                           const struct animkeyframe_priv *kf)
+{
+    struct buffer_priv *s = user_arg;
+    const int kf_id = kf == s->anim.kfs[0] ? 0 : s->anim.nb_kfs - 1;
+    s->mix_kfs[0] = s->mix_kfs[1] = kf_id;
+    s->mix_ratio = 0.f;
+}
+
+int ngli_node_animatedbuffer_mix(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+
+    if (!s->buffer_mix.ctx) {
+        const float **kfs_data = ngli_calloc(s->nb_animkf, sizeof(*kfs_data));
+        if (!kfs_data)
+            return NGL_ERROR_MEMORY;
+        for (int i = 0; i < s->nb_animkf; i++) {
+            const struct animkeyframe_priv *kf = s->animkf[i]->priv_data;
+            kfs_data[i] = (const float *)kf->data;
+        }
+        int ret = ngli_buffer_mix_init(&s->buffer_mix, node->ctx, s->buffer,
+                                       kfs_data, s->nb_animkf, s->count * s->data_comp);
+        ngli_free(kfs_data);
+        if (ret < 0) {
+            ngli_buffer_mix_reset(&s->buffer_mix);
+            return ret;
+        }
+    }
+
+    return ngli_buffer_mix_exec(&s->buffer_mix, s->mix_kfs[0], s->mix_kfs[1], s->mix_ratio);
+}
+
+#define FEATURES_GPU_EVAL (NGLI_FEATURE_COMPUTE_SHADER | NGLI_FEATURE_SHADER_STORAGE_BUFFER_OBJECT)
+
 static int animatedbuffer_update(struct ngl_node *node, double t)
 {
     struct buffer_priv *s = node->priv_data;
@@ -75,9 +126,19 @@ static int animatedbuffer_init(struct ngl_node *node)
     s->data_comp = ngli_format_get_nb_comp(s->data_format);
     s->data_stride = ngli_format_get_bytes_per_pixel(s->data_format);
 
+    if (s->gpu_eval) {
+        const struct gpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+        if ((gpu_ctx->features & FEATURES_GPU_EVAL) != FEATURES_GPU_EVAL) {
+            LOG(ERROR, "GPU evaluation requires compute shaders and storage buffers support");
+            return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+        }
+        s->usage = NGLI_BUFFER_USAGE_TRANSFER_DST_BIT | NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+
     int ret = ngli_animation_init(&s->anim, s,
                                   s->animkf, s->nb_animkf,
-                                  mix_buffer, cpy_buffer);
+                                  s->gpu_eval ? mix_buffer_gpu : mix_buffer,
+                                  s->gpu_eval ? cpy_buffer_gpu : cpy_buffer);
     if (ret < 0)
         return ret;
 
@@ -115,6 +176,8 @@ static void animatedbuffer_uninit(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
 
+    ngli_buffer_mix_reset(&s->buffer_mix);
+    ngli_animation_reset(&s->anim);
     ngli_freep(&s->data);
 }
 
@@ -130,6 +193,7 @@ static int animatedbuffer##type##_init(struct ngl_node *node)
 const struct node_class ngli_animatedbuffer##type##_class = {                      \
     .id        = class_id,                                                         \
     .category  = NGLI_NODE_CATEGORY_BUFFER,                                        \
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE | NGLI_NODE_FLAG_TIME_VARYING,   \
     .name      = class_name,                                                       \
     .init      = animatedbuffer##type##_init,                                      \
     .update    = animatedbuffer_update,                                            \
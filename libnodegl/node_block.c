@@ -148,6 +148,10 @@ int ngli_node_block_init(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
+    struct ngl_ctx *ctx = node->ctx;
+    ctx->upload_size += s->data_size;
+    ngli_darray_clear(&s->dirty_ranges);
+
     return 0;
 }
 
@@ -164,12 +168,19 @@ int ngli_node_block_upload(struct ngl_node *node)
 {
     struct block_priv *s = node->priv_data;
 
-    if (s->has_changed && s->buffer_last_upload_time != node->last_update_time) {
-        int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0);
-        if (ret < 0)
-            return ret;
+    const int nb_ranges = ngli_darray_count(&s->dirty_ranges);
+    if (nb_ranges && s->buffer_last_upload_time != node->last_update_time) {
+        struct ngl_ctx *ctx = node->ctx;
+        const struct block_range *ranges = ngli_darray_data(&s->dirty_ranges);
+        for (int i = 0; i < nb_ranges; i++) {
+            const struct block_range *range = &ranges[i];
+            int ret = ngli_buffer_upload(s->buffer, s->data + range->offset, range->size, range->offset);
+            if (ret < 0)
+                return ret;
+            ctx->upload_size += range->size;
+        }
         s->buffer_last_upload_time = node->last_update_time;
-        s->has_changed = 0;
+        ngli_darray_clear(&s->dirty_ranges);
     }
 
     return 0;
@@ -238,7 +249,57 @@ static const struct {
     [IS_ARRAY]  = {has_changed_buffer,  update_buffer_field},
 };
 
-static void update_block_data(struct block_priv *s, int forced)
+/*
+ * Dirty ranges separated by less than this number of bytes are merged into a
+ * single upload, since issuing one more upload call is generally more
+ * expensive than transferring a few extra bytes.
+ */
+#define RANGE_MERGE_GAP 256
+
+static int mark_dirty_range(struct block_priv *s, int offset, int size)
+{
+    /*
+     * Within an update, the fields come by increasing offset so the new range
+     * generally extends the last one or follows it. The ranges of a previous
+     * update may still be pending though (not uploaded yet), so the range is
+     * inserted at its place and merged with all the ranges it gets close to.
+     */
+    struct block_range *ranges = ngli_darray_data(&s->dirty_ranges);
+    const int nb_ranges = ngli_darray_count(&s->dirty_ranges);
+    int start = offset;
+    int end = offset + size;
+
+    /* First range ending close enough to the new one, or after it */
+    int i = nb_ranges;
+    while (i > 0 && ranges[i - 1].offset + ranges[i - 1].size + RANGE_MERGE_GAP >= start)
+        i--;
+
+    /* Ranges starting close enough to the new one are merged into it */
+    int j = i;
+    while (j < nb_ranges && ranges[j].offset <= end + RANGE_MERGE_GAP) {
+        start = NGLI_MIN(start, ranges[j].offset);
+        end = NGLI_MAX(end, ranges[j].offset + ranges[j].size);
+        j++;
+    }
+
+    const struct block_range range = {.offset = start, .size = end - start};
+    if (i == j) {
+        if (!ngli_darray_push(&s->dirty_ranges, &range))
+            return NGL_ERROR_MEMORY;
+        ranges = ngli_darray_data(&s->dirty_ranges);
+        memmove(&ranges[i + 1], &ranges[i], (nb_ranges - i) * sizeof(*ranges));
+        ranges[i] = range;
+        return 0;
+    }
+
+    ranges[i] = range;
+    memmove(&ranges[i + 1], &ranges[j], (nb_ranges - j) * sizeof(*ranges));
+    for (int k = i + 1; k < j; k++)
+        ngli_darray_pop(&s->dirty_ranges);
+    return 0;
+}
+
+static int update_block_data(struct block_priv *s, int forced)
 {
     const struct block_field *field_info = ngli_darray_data(&s->block.fields);
     for (int i = 0; i < s->nb_fields; i++) {
@@ -247,8 +308,11 @@ static void update_block_data(struct block_priv *s, int forced)
         if (!forced && !field_funcs[fi->count ? IS_ARRAY : IS_SINGLE].has_changed(field_node))
             continue;
         field_funcs[fi->count ? IS_ARRAY : IS_SINGLE].update_data(s->data + fi->offset, field_node, fi);
-        s->has_changed = 1; // TODO: only re-upload the changing data segments
+        int ret = mark_dirty_range(s, fi->offset, fi->size);
+        if (ret < 0)
+            return ret;
     }
+    return 0;
 }
 
 static int cmp_str(const void *a, const void *b)
@@ -320,6 +384,15 @@ static int block_init(struct ngl_node *node)
         const int type  = get_node_data_type(field_node);
         const int count = get_node_data_count(field_node);
 
+        if (field_node->cls->category == NGLI_NODE_CATEGORY_BUFFER) {
+            const struct buffer_priv *field_priv = field_node->priv_data;
+            if (field_priv->gpu_eval) {
+                LOG(ERROR, "%s is evaluated on the GPU and can not be used as a block field",
+                    field_node->label);
+                return NGL_ERROR_INVALID_USAGE;
+            }
+        }
+
         int ret = ngli_block_add_field(&s->block, field_node->label, type, count);
         if (ret < 0)
             return ret;
@@ -339,8 +412,9 @@ static int block_init(struct ngl_node *node)
     if (!s->data)
         return NGL_ERROR_MEMORY;
 
-    update_block_data(s, 1);
-    return 0;
+    ngli_darray_init(&s->dirty_ranges, sizeof(struct block_range), 0);
+
+    return update_block_data(s, 1);
 }
 
 static int block_invalidate(struct ngl_node *node)
@@ -364,7 +438,9 @@ static int block_update(struct ngl_node *node, double t)
             return ret;
     }
 
-    update_block_data(s, s->force_update);
+    int ret = update_block_data(s, s->force_update);
+    if (ret < 0)
+        return ret;
     s->force_update = 0;
 
     return 0;
@@ -375,12 +451,14 @@ static void block_uninit(struct ngl_node *node)
     struct block_priv *s = node->priv_data;
 
     ngli_block_reset(&s->block);
+    ngli_darray_reset(&s->dirty_ranges);
     ngli_free(s->data);
 }
 
 const struct node_class ngli_block_class = {
     .id        = NGL_NODE_BLOCK,
     .category  = NGLI_NODE_CATEGORY_BLOCK,
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE,
     .name      = "Block",
     .init      = block_init,
     .invalidate = block_invalidate,
@@ -102,8 +102,10 @@ void ngli_node_buffer_unref(struct ngl_node *node)
     }
 
     ngli_assert(s->buffer_refcount);
-    if (s->buffer_refcount-- == 1)
+    if (s->buffer_refcount-- == 1) {
+        ngli_buffer_mix_reset(&s->buffer_mix);
         ngli_buffer_freep(&s->buffer);
+    }
 }
 
 int ngli_node_buffer_upload(struct ngl_node *node)
@@ -114,9 +116,17 @@ int ngli_node_buffer_upload(struct ngl_node *node)
         return ngli_node_block_upload(s->block);
 
     if (s->dynamic && s->buffer_last_upload_time != node->last_update_time) {
-        int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0);
-        if (ret < 0)
-            return ret;
+        if (s->gpu_eval) {
+            int ret = ngli_node_animatedbuffer_mix(node);
+            if (ret < 0)
+                return ret;
+        } else {
+            int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0);
+            if (ret < 0)
+                return ret;
+            struct ngl_ctx *ctx = node->ctx;
+            ctx->upload_size += s->data_size;
+        }
         s->buffer_last_upload_time = node->last_update_time;
     }
 
@@ -166,26 +176,15 @@ static int buffer_init_from_filename(struct ngl_node *node)
         return NGL_ERROR_INVALID_DATA;
     }
 
-    s->data = ngli_calloc(s->count, s->data_stride);
-    if (!s->data)
-        return NGL_ERROR_MEMORY;
-
-    s->fp = fopen(s->filename, "rb");
-    if (!s->fp) {
-        LOG(ERROR, "could not open '%s'", s->filename);
-        return NGL_ERROR_IO;
-    }
-
-    size_t n = fread(s->data, 1, s->data_size, s->fp);
-    if (n != s->data_size) {
-        LOG(ERROR, "could not read '%s'", s->filename);
-        return NGL_ERROR_IO;
-    }
-
-    if (n != s->data_size) {
-        LOG(ERROR, "read %zd bytes does not match expected size of %d bytes", n, s->data_size);
-        return NGL_ERROR_IO;
-    }
+    /*
+     * The file is mapped instead of read so that large buffers, typically
+     * used as Streamed* sources, only have their accessed parts resident.
+     */
+    void *data;
+    ret = ngli_map_file(s->filename, s->data_size, &data);
+    if (ret < 0)
+        return ret;
+    s->data = data;
 
     return 0;
 }
@@ -281,15 +280,10 @@ static void buffer_uninit(struct ngl_node *node)
     struct buffer_priv *s = node->priv_data;
 
     if (s->filename) {
-        ngli_freep(&s->data);
+        void *data = s->data;
+        ngli_unmap_file(&data, s->data_size);
+        s->data = NULL;
         s->data_size = 0;
-
-        if (s->fp) {
-            int ret = fclose(s->fp);
-            if (ret < 0) {
-                LOG(ERROR, "could not properly close '%s'", s->filename);
-            }
-        }
     } else if (s->block) {
         /* Prevent the param API to free a non-owned pointer */
         s->data = NULL;
@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "drawlist.h"
 #include "gpu_ctx.h"
 #include "graphicstate.h"
 #include "log.h"
@@ -310,6 +311,16 @@ static void graphicconfig_draw(struct ngl_node *node)
         ngli_gpu_ctx_set_scissor(gpu_ctx, prev_scissor);
 }
 
+static int graphicconfig_compile(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct graphicconfig_priv *s = node->priv_data;
+
+    /* The scissor needs to be restored after the child, so keep the branch as is */
+    if (s->use_scissor)
+        return ngli_drawlist_add_draw(drawlist, node);
+    return ngli_drawlist_add_node(drawlist, s->child);
+}
+
 const struct node_class ngli_graphicconfig_class = {
     .id        = NGL_NODE_GRAPHICCONFIG,
     .name      = "GraphicConfig",
@@ -317,6 +328,7 @@ const struct node_class ngli_graphicconfig_class = {
     .prepare   = graphicconfig_prepare,
     .update    = graphicconfig_update,
     .draw      = graphicconfig_draw,
+    .compile   = graphicconfig_compile,
     .priv_size = sizeof(struct graphicconfig_priv),
     .params    = graphicconfig_params,
     .file      = __FILE__,
@@ -22,6 +22,7 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
+#include "drawlist.h"
 #include "nodegl.h"
 #include "nodes.h"
 
@@ -90,12 +91,32 @@ static void group_draw(struct ngl_node *node)
     ctx->rnode_pos = rnode_pos;
 }
 
+static int group_compile(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct group_priv *s = node->priv_data;
+
+    int ret = 0;
+    struct rnode *rnode_pos = ctx->rnode_pos;
+    struct rnode *rnodes = ngli_darray_data(&rnode_pos->children);
+    for (int i = 0; i < s->nb_children; i++) {
+        ctx->rnode_pos = &rnodes[i];
+        struct ngl_node *child = s->children[i];
+        ret = ngli_drawlist_add_node(drawlist, child);
+        if (ret < 0)
+            break;
+    }
+    ctx->rnode_pos = rnode_pos;
+    return ret;
+}
+
 const struct node_class ngli_group_class = {
     .id        = NGL_NODE_GROUP,
     .name      = "Group",
     .prepare   = group_prepare,
     .update    = group_update,
     .draw      = group_draw,
+    .compile   = group_compile,
     .priv_size = sizeof(struct group_priv),
     .params    = group_params,
     .file      = __FILE__,
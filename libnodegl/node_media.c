@@ -327,6 +327,7 @@ static void media_uninit(struct ngl_node *node)
 
 const struct node_class ngli_media_class = {
     .id        = NGL_NODE_MEDIA,
+    .flags     = NGLI_NODE_FLAG_TIME_VARYING | NGLI_NODE_FLAG_ASYNC_PREFETCH,
     .name      = "Media",
     .init      = media_init,
     .prepare   = media_prepare,
@@ -31,10 +31,11 @@ struct noise_priv {
     struct variable_priv var;
     double frequency;
     struct noise_params generator_params;
-    struct noise generator[4];
+    struct noise generator;
+    uint32_t seeds[4];
 };
 
-const struct param_choices noise_func_choices = {
+const struct param_choices ngli_noise_func_choices = {
     .name = "interp_noise",
     .consts = {
         {"linear",  NGLI_NOISE_LINEAR,  .desc=NGLI_DOCSTRING("linear interpolation (not recommended), f(t)=t")},
@@ -64,7 +65,7 @@ static const struct node_param noise_params[] = {
     {"seed",        NGLI_PARAM_TYPE_UINT, OFFSET(generator_params.seed), {.i64=0},
                     .desc=NGLI_DOCSTRING("random base seed (acts as an offsetting to the time)")},
     {"interpolant", NGLI_PARAM_TYPE_SELECT, OFFSET(generator_params.function), {.i64=NGLI_NOISE_QUINTIC},
-                    .choices=&noise_func_choices,
+                    .choices=&ngli_noise_func_choices,
                     .desc=NGLI_DOCSTRING("interpolation function to use between noise points")},
     {NULL}
 };
@@ -74,16 +75,14 @@ NGLI_STATIC_ASSERT(variable_priv_is_first, OFFSET(var) == 0);
 static int noisefloat_update(struct ngl_node *node, double t)
 {
     struct noise_priv *s = node->priv_data;
-    s->var.scalar = ngli_noise_get(&s->generator[0], t * s->frequency);
+    s->var.scalar = ngli_noise_get(&s->generator, t * s->frequency);
     return 0;
 }
 
 static int noisevec_update(struct ngl_node *node, double t, int n)
 {
     struct noise_priv *s = node->priv_data;
-    const float v = t * s->frequency;
-    for (int i = 0; i < n; i++)
-        s->var.vector[i] = ngli_noise_get(&s->generator[i], v);
+    ngli_noise_get_vec(&s->generator, s->var.vector, t * s->frequency, s->seeds, n);
     return 0;
 }
 
@@ -105,43 +104,41 @@ static int noisevec4_update(struct ngl_node *node, double t)
 static int init_noise_generators(struct noise_priv *s, int n)
 {
     /*
-     * Every generator is instanciated the same, except for the seed: the seed
+     * Every component is generated the same, except for the seed: the seed
      * offset is defined to create a large gap between every components to keep
-     * the overlap to the minimum possible
+     * the overlap to the minimum possible. All the components are evaluated
+     * together by the 4-lane noise kernel.
      */
     const uint32_t seed_offset = UINT32_MAX / n;
     uint32_t seed = s->generator_params.seed;
     for (int i = 0; i < n; i++) {
-        struct noise_params np = s->generator_params;
-        np.seed = seed;
-        int ret = ngli_noise_init(&s->generator[i], &np);
-        if (ret < 0)
-            return ret;
+        s->seeds[i] = seed;
         seed += seed_offset;
     }
-    return 0;
+    return ngli_noise_init(&s->generator, &s->generator_params);
 }
 
-#define DEFINE_NOISE_CLASS(class_id, class_name, type, dtype, count, dst)   \
-static int noise##type##_init(struct ngl_node *node)                        \
-{                                                                           \
-    struct noise_priv *s = node->priv_data;                                 \
-    s->var.data = dst;                                                      \
-    s->var.data_size = count * sizeof(float);                               \
-    s->var.data_type = dtype;                                               \
-    return init_noise_generators(s, count);                                 \
-}                                                                           \
-                                                                            \
-const struct node_class ngli_noise##type##_class = {                        \
-    .id        = class_id,                                                  \
-    .category  = NGLI_NODE_CATEGORY_UNIFORM,                                \
-    .name      = class_name,                                                \
-    .init      = noise##type##_init,                                        \
-    .update    = noise##type##_update,                                      \
-    .priv_size = sizeof(struct noise_priv),                                 \
-    .params    = noise_params,                                              \
-    .params_id = "Noise",                                                   \
-    .file      = __FILE__,                                                  \
+#define DEFINE_NOISE_CLASS(class_id, class_name, type, dtype, count, dst)        \
+static int noise##type##_init(struct ngl_node *node)                             \
+{                                                                                \
+    struct noise_priv *s = node->priv_data;                                      \
+    s->var.data = dst;                                                           \
+    s->var.data_size = count * sizeof(float);                                    \
+    s->var.data_type = dtype;                                                    \
+    return init_noise_generators(s, count);                                      \
+}                                                                                \
+                                                                                 \
+const struct node_class ngli_noise##type##_class = {                             \
+    .id        = class_id,                                                       \
+    .category  = NGLI_NODE_CATEGORY_UNIFORM,                                     \
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE | NGLI_NODE_FLAG_TIME_VARYING, \
+    .name      = class_name,                                                     \
+    .init      = noise##type##_init,                                             \
+    .update    = noise##type##_update,                                           \
+    .priv_size = sizeof(struct noise_priv),                                      \
+    .params    = noise_params,                                                   \
+    .params_id = "Noise",                                                        \
+    .file      = __FILE__,                                                       \
 };
 
 DEFINE_NOISE_CLASS(NGL_NODE_NOISEFLOAT, "NoiseFloat", float, NGLI_TYPE_FLOAT, 1, &s->var.scalar)
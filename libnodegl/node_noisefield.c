@@ -0,0 +1,503 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+
+#include "block.h"
+#include "bstr.h"
+#include "gpu_ctx.h"
+#include "log.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "noise.h"
+#include "pgcraft.h"
+#include "pipeline.h"
+#include "type.h"
+#include "utils.h"
+
+enum {
+    UNIFORM_TIME,
+    UNIFORM_AMPLITUDE,
+    UNIFORM_LACUNARITY,
+    UNIFORM_GAIN,
+    UNIFORM_OCTAVES,
+    UNIFORM_INTERPOLANT,
+    UNIFORM_SEEDS,
+    UNIFORM_NB
+};
+
+/* Everything a generated field depends on */
+struct field_state {
+    float time;
+    float amplitude;
+    float lacunarity;
+    float gain;
+    int octaves;
+    int interpolant;
+    int seeds[2];
+    struct texture *texture;
+};
+
+struct noisefield_priv {
+    struct ngl_node *target;
+    double frequency;
+    struct noise_params generator_params;
+
+    struct ngl_node *buffer_node; /* referenced target buffer */
+    int nb_generators;
+    int nb_groups[2];
+    struct block block;
+    struct pgcraft *crafter;
+    struct pipeline *pipeline;
+    int uniform_indexes[UNIFORM_NB];
+    int texture_index;
+
+    struct field_state state;
+    struct field_state last_state;
+    int generated;
+};
+
+#define TARGET_TYPES_LIST (const int[]){NGL_NODE_BUFFERFLOAT, \
+                                        NGL_NODE_BUFFERVEC2,  \
+                                        NGL_NODE_BUFFERVEC3,  \
+                                        NGL_NODE_BUFFERVEC4,  \
+                                        NGL_NODE_TEXTURE2D,   \
+                                        -1}
+
+#define OFFSET(x) offsetof(struct noisefield_priv, x)
+static const struct node_param noisefield_params[] = {
+    {"target",      NGLI_PARAM_TYPE_NODE, OFFSET(target),
+                    .flags=NGLI_PARAM_FLAG_NON_NULL,
+                    .node_types=TARGET_TYPES_LIST,
+                    .desc=NGLI_DOCSTRING("buffer or texture to fill with the noise field; every component "
+                                         "is a generator of its own, seeded the same way as the components "
+                                         "of the `Noise*` nodes")},
+    {"frequency",   NGLI_PARAM_TYPE_DBL, OFFSET(frequency), {.dbl=1.},
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("oscillation per second")},
+    {"amplitude",   NGLI_PARAM_TYPE_DBL, OFFSET(generator_params.amplitude), {.dbl=1.},
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("by how much it oscillates")},
+    {"octaves",     NGLI_PARAM_TYPE_INT, OFFSET(generator_params.octaves), {.i64=3},
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("number of accumulated noise layers (controls the level of details)")},
+    {"lacunarity",  NGLI_PARAM_TYPE_DBL, OFFSET(generator_params.lacunarity), {.dbl=2.0},
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("frequency multiplier per octave")},
+    {"gain",        NGLI_PARAM_TYPE_DBL, OFFSET(generator_params.gain), {.dbl=0.5},
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("amplitude multiplier per octave (also known as persistence)")},
+    {"seed",        NGLI_PARAM_TYPE_UINT, OFFSET(generator_params.seed), {.i64=0},
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("random base seed (acts as an offsetting to the time)")},
+    {"interpolant", NGLI_PARAM_TYPE_SELECT, OFFSET(generator_params.function), {.i64=NGLI_NOISE_QUINTIC},
+                    .choices=&ngli_noise_func_choices,
+                    .flags=NGLI_PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .desc=NGLI_DOCSTRING("interpolation function to use between noise points")},
+    {NULL}
+};
+
+#define WORKGROUP_SIZE_1D 64
+#define WORKGROUP_SIZE_2D 8
+
+/*
+ * GLSL version of the noise.c generator, spelled out the same way as
+ * ngli_noise_fbm4_c() so the results match the CPU path
+ */
+static const char *noise_glsl =
+    "uint hash(uint x)"                                                         "\n"
+    "{"                                                                         "\n"
+    "    x ^= x >> 16u;"                                                        "\n"
+    "    x *= 0x7feb352du;"                                                     "\n"
+    "    x ^= x >> 15u;"                                                        "\n"
+    "    x *= 0x846ca68bu;"                                                     "\n"
+    "    x ^= x >> 16u;"                                                        "\n"
+    "    return x;"                                                             "\n"
+    "}"                                                                         "\n"
+    ""                                                                          "\n"
+    "float get_slope(uint x)"                                                   "\n"
+    "{"                                                                         "\n"
+    "    return (uintBitsToFloat(0x3f800000u | (x >> 9u)) - 1.0) * 2.0 - 1.0;" "\n"
+    "}"                                                                         "\n"
+    ""                                                                          "\n"
+    "float curve(float t)"                                                      "\n"
+    "{"                                                                         "\n"
+    "    if (interpolant == NOISE_LINEAR)"                                      "\n"
+    "        return t;"                                                         "\n"
+    "    if (interpolant == NOISE_CUBIC)"                                       "\n"
+    "        return (3.0 - 2.0*t)*t*t;"                                         "\n"
+    "    return ((6.0*t - 15.0)*t + 10.0)*t*t*t;"                               "\n"
+    "}"                                                                         "\n"
+    ""                                                                          "\n"
+    "float noise(float t, uint seed)"                                           "\n"
+    "{"                                                                         "\n"
+    "    float i = floor(t);"                                                   "\n"
+    "    float f = t - i;"                                                      "\n"
+    "    uint x = uint(int(i)) + seed;"                                         "\n"
+    "    float y0 = get_slope(hash(x)) * f;"                                    "\n"
+    "    float y1 = get_slope(hash(x + 1u)) * (f - 1.0);"                       "\n"
+    "    return y0 + (y1 - y0) * curve(f);"                                     "\n"
+    "}"                                                                         "\n"
+    ""                                                                          "\n"
+    "float fbm(uint seed)"                                                      "\n"
+    "{"                                                                         "\n"
+    "    float t = time;"                                                       "\n"
+    "    float amp = amplitude;"                                                "\n"
+    "    float sum = 0.0;"                                                      "\n"
+    "    for (int i = 0; i < octaves; i++) {"                                   "\n"
+    "        sum += noise(t, seed) * amp;"                                      "\n"
+    "        t *= lacunarity;"                                                  "\n"
+    "        amp *= gain;"                                                      "\n"
+    "    }"                                                                     "\n"
+    "    return sum;"                                                           "\n"
+    "}"                                                                         "\n"
+    ""                                                                          "\n";
+
+static const char *buffer_main =
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    uint n = uint(dst.data.length());"                                     "\n"
+    "    uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;"                "\n"
+    "    uvec2 s = uvec2(seeds);"                                               "\n"
+    "    for (uint i = gl_GlobalInvocationID.x; i < n; i += stride)"            "\n"
+    "        dst.data[i] = fbm(s.x + i * s.y);"                                 "\n"
+    "}";
+
+static const char *texture_main =
+    "void main()"                                                               "\n"
+    "{"                                                                         "\n"
+    "    ivec2 size = imageSize(dst);"                                          "\n"
+    "    ivec2 pos = ivec2(gl_GlobalInvocationID.xy);"                          "\n"
+    "    if (pos.x >= size.x || pos.y >= size.y)"                               "\n"
+    "        return;"                                                           "\n"
+    "    uvec2 s = uvec2(seeds);"                                               "\n"
+    "    uint seed = s.x + uint(pos.y * size.x + pos.x) * 4u * s.y;"            "\n"
+    "    vec4 v = vec4(fbm(seed),"                                              "\n"
+    "                  fbm(seed + s.y),"                                        "\n"
+    "                  fbm(seed + 2u * s.y),"                                   "\n"
+    "                  fbm(seed + 3u * s.y));"                                  "\n"
+    "    imageStore(dst, pos, v);"                                              "\n"
+    "}";
+
+static const struct {
+    const char *name;
+    int type;
+} uniforms_desc[UNIFORM_NB] = {
+    [UNIFORM_TIME]        = {"time",        NGLI_TYPE_FLOAT},
+    [UNIFORM_AMPLITUDE]   = {"amplitude",   NGLI_TYPE_FLOAT},
+    [UNIFORM_LACUNARITY]  = {"lacunarity",  NGLI_TYPE_FLOAT},
+    [UNIFORM_GAIN]        = {"gain",        NGLI_TYPE_FLOAT},
+    [UNIFORM_OCTAVES]     = {"octaves",     NGLI_TYPE_INT},
+    [UNIFORM_INTERPOLANT] = {"interpolant", NGLI_TYPE_INT},
+    [UNIFORM_SEEDS]       = {"seeds",       NGLI_TYPE_IVEC2},
+};
+
+static const void *get_uniform_data(const struct field_state *state, int uniform)
+{
+    switch (uniform) {
+    case UNIFORM_TIME:        return &state->time;
+    case UNIFORM_AMPLITUDE:   return &state->amplitude;
+    case UNIFORM_LACUNARITY:  return &state->lacunarity;
+    case UNIFORM_GAIN:        return &state->gain;
+    case UNIFORM_OCTAVES:     return &state->octaves;
+    case UNIFORM_INTERPOLANT: return &state->interpolant;
+    case UNIFORM_SEEDS:       return state->seeds;
+    default:                  ngli_assert(0);
+    }
+    return NULL;
+}
+
+#define FEATURES_BUFFER  (NGLI_FEATURE_COMPUTE_SHADER | NGLI_FEATURE_SHADER_STORAGE_BUFFER_OBJECT)
+#define FEATURES_TEXTURE (NGLI_FEATURE_COMPUTE_SHADER | NGLI_FEATURE_SHADER_IMAGE_LOAD_STORE)
+
+static int noisefield_init(struct ngl_node *node)
+{
+    struct noisefield_priv *s = node->priv_data;
+    const struct gpu_ctx *gpu_ctx = node->ctx->gpu_ctx;
+    struct ngl_node *target = s->target;
+
+    if (target->cls->id == NGL_NODE_TEXTURE2D) {
+        if ((gpu_ctx->features & FEATURES_TEXTURE) != FEATURES_TEXTURE) {
+            LOG(ERROR, "noise fields in textures require compute shaders and image load/store support");
+            return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+        }
+
+        struct texture_priv *texture_priv = target->priv_data;
+        if (texture_priv->data_src) {
+            LOG(ERROR, "the noise field target texture can not have a data source");
+            return NGL_ERROR_INVALID_USAGE;
+        }
+
+        /* Same as the textures accessed as images by the Compute nodes */
+        texture_priv->supported_image_layouts = 1 << NGLI_IMAGE_LAYOUT_DEFAULT;
+        texture_priv->params.usage |= NGLI_TEXTURE_USAGE_STORAGE_BIT;
+
+        s->nb_generators = texture_priv->params.width * texture_priv->params.height * 4;
+    } else {
+        if ((gpu_ctx->features & FEATURES_BUFFER) != FEATURES_BUFFER) {
+            LOG(ERROR, "noise fields in buffers require compute shaders and storage buffers support");
+            return NGL_ERROR_GRAPHICS_UNSUPPORTED;
+        }
+
+        struct buffer_priv *buffer_priv = target->priv_data;
+        if (buffer_priv->block) {
+            LOG(ERROR, "the noise field target buffer can not reference a block");
+            return NGL_ERROR_INVALID_USAGE;
+        }
+
+        s->nb_generators = buffer_priv->count * buffer_priv->data_comp;
+    }
+
+    if (s->nb_generators <= 0) {
+        LOG(ERROR, "the noise field target can not be empty");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (target->cls->id != NGL_NODE_TEXTURE2D) {
+        int ret = ngli_node_buffer_ref(target);
+        if (ret < 0)
+            return ret;
+        s->buffer_node = target;
+
+        struct buffer_priv *buffer_priv = target->priv_data;
+        buffer_priv->usage |= NGLI_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+
+    return 0;
+}
+
+static int craft_pipeline(struct ngl_node *node)
+{
+    struct noisefield_priv *s = node->priv_data;
+    struct ngl_ctx *ctx = node->ctx;
+    struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+    const struct gpu_limits *limits = &gpu_ctx->limits;
+    struct ngl_node *target = s->target;
+    const int is_texture = target->cls->id == NGL_NODE_TEXTURE2D;
+
+    struct pgcraft_uniform uniforms[UNIFORM_NB] = {0};
+    for (int i = 0; i < UNIFORM_NB; i++) {
+        struct pgcraft_uniform *uniform = &uniforms[i];
+        snprintf(uniform->name, sizeof(uniform->name), "%s", uniforms_desc[i].name);
+        uniform->type  = uniforms_desc[i].type;
+        uniform->stage = NGLI_PROGRAM_SHADER_COMP;
+        uniform->data  = get_uniform_data(&s->state, i);
+    }
+
+    struct pgcraft_texture texture = {
+        .name     = "dst",
+        .type     = NGLI_PGCRAFT_SHADER_TEX_TYPE_IMAGE_2D,
+        .stage    = NGLI_PROGRAM_SHADER_COMP,
+        .writable = 1,
+    };
+
+    struct pgcraft_block block = {
+        .name     = "dst",
+        .type     = NGLI_TYPE_STORAGE_BUFFER,
+        .stage    = NGLI_PROGRAM_SHADER_COMP,
+        .writable = 1,
+        .block    = &s->block,
+    };
+
+    struct pgcraft_params crafter_params = {
+        .uniforms    = uniforms,
+        .nb_uniforms = NGLI_ARRAY_NB(uniforms),
+    };
+
+    if (is_texture) {
+        struct texture_priv *texture_priv = target->priv_data;
+        texture.format = texture_priv->params.format;
+        texture.image  = &texture_priv->image;
+        crafter_params.textures    = &texture;
+        crafter_params.nb_textures = 1;
+
+        const int width  = texture_priv->params.width;
+        const int height = texture_priv->params.height;
+        s->nb_groups[0] = (width  + WORKGROUP_SIZE_2D - 1) / WORKGROUP_SIZE_2D;
+        s->nb_groups[1] = (height + WORKGROUP_SIZE_2D - 1) / WORKGROUP_SIZE_2D;
+        if (s->nb_groups[0] > limits->max_compute_work_group_count[0] ||
+            s->nb_groups[1] > limits->max_compute_work_group_count[1]) {
+            LOG(ERROR, "noise field texture dimensions (%d,%d) exceed device limits", width, height);
+            return NGL_ERROR_GRAPHICS_LIMIT_EXCEEDED;
+        }
+        crafter_params.workgroup_size[0] = WORKGROUP_SIZE_2D;
+        crafter_params.workgroup_size[1] = WORKGROUP_SIZE_2D;
+        crafter_params.workgroup_size[2] = 1;
+    } else {
+        struct buffer_priv *buffer_priv = target->priv_data;
+        int ret = ngli_node_buffer_init(target);
+        if (ret < 0)
+            return ret;
+
+        ngli_block_init(&s->block, NGLI_BLOCK_LAYOUT_STD430);
+        ret = ngli_block_add_field(&s->block, "data", NGLI_TYPE_FLOAT, s->nb_generators);
+        if (ret < 0)
+            return ret;
+        block.buffer = buffer_priv->buffer;
+        crafter_params.blocks    = &block;
+        crafter_params.nb_blocks = 1;
+
+        /* The shader loops over the values in excess of the dispatch size */
+        const int nb_groups = (s->nb_generators + WORKGROUP_SIZE_1D - 1) / WORKGROUP_SIZE_1D;
+        s->nb_groups[0] = NGLI_MIN(nb_groups, limits->max_compute_work_group_count[0]);
+        s->nb_groups[1] = 1;
+        crafter_params.workgroup_size[0] = WORKGROUP_SIZE_1D;
+        crafter_params.workgroup_size[1] = 1;
+        crafter_params.workgroup_size[2] = 1;
+    }
+
+    struct bstr *comp_base = ngli_bstr_create();
+    if (!comp_base)
+        return NGL_ERROR_MEMORY;
+    ngli_bstr_printf(comp_base, "#define NOISE_LINEAR %d\n"
+                                "#define NOISE_CUBIC %d\n",
+                     NGLI_NOISE_LINEAR, NGLI_NOISE_CUBIC);
+    ngli_bstr_print(comp_base, noise_glsl);
+    ngli_bstr_print(comp_base, is_texture ? texture_main : buffer_main);
+    crafter_params.comp_base = ngli_bstr_strptr(comp_base);
+
+    struct pipeline_params pipeline_params = {
+        .type = NGLI_PIPELINE_TYPE_COMPUTE,
+    };
+    struct pipeline_resource_params pipeline_resource_params = {0};
+
+    s->crafter = ngli_pgcraft_create(ctx);
+    if (!s->crafter) {
+        ngli_bstr_freep(&comp_base);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = ngli_pgcraft_craft(s->crafter, &pipeline_params, &pipeline_resource_params, &crafter_params);
+    ngli_bstr_freep(&comp_base);
+    if (ret < 0)
+        return ret;
+
+    s->pipeline = ngli_pipeline_create(gpu_ctx);
+    if (!s->pipeline)
+        return NGL_ERROR_MEMORY;
+
+    if ((ret = ngli_pipeline_init(s->pipeline, &pipeline_params)) < 0 ||
+        (ret = ngli_pipeline_set_resources(s->pipeline, &pipeline_resource_params)) < 0)
+        return ret;
+
+    for (int i = 0; i < UNIFORM_NB; i++)
+        s->uniform_indexes[i] = ngli_pgcraft_get_uniform_index(s->crafter, uniforms_desc[i].name,
+                                                               NGLI_PROGRAM_SHADER_COMP);
+
+    if (is_texture) {
+        const struct pgcraft_texture_info *info = ngli_darray_data(&s->crafter->texture_infos);
+        s->texture_index = info->fields[NGLI_INFO_FIELD_SAMPLER_0].index;
+    }
+
+    return 0;
+}
+
+static int noisefield_prepare(struct ngl_node *node)
+{
+    struct noisefield_priv *s = node->priv_data;
+    if (s->pipeline)
+        return 0;
+    return craft_pipeline(node);
+}
+
+static int noisefield_update(struct ngl_node *node, double t)
+{
+    struct noisefield_priv *s = node->priv_data;
+    const struct noise_params *np = &s->generator_params;
+
+    /* Same seeds distribution as the components of the NoiseVec* nodes */
+    const uint32_t seed_offset = UINT32_MAX / s->nb_generators;
+    s->state = (struct field_state){
+        .time        = t * s->frequency,
+        .amplitude   = np->amplitude,
+        .lacunarity  = np->lacunarity,
+        .gain        = np->gain,
+        .octaves     = np->octaves,
+        .interpolant = np->function,
+        .seeds       = {(int)np->seed, (int)seed_offset},
+    };
+
+    return ngli_node_update(s->target, t);
+}
+
+static void noisefield_draw(struct ngl_node *node)
+{
+    struct noisefield_priv *s = node->priv_data;
+    struct ngl_ctx *ctx = node->ctx;
+    struct ngl_node *target = s->target;
+
+    if (target->cls->id == NGL_NODE_TEXTURE2D) {
+        struct texture_priv *texture_priv = target->priv_data;
+        s->state.texture = texture_priv->texture;
+        if (!s->state.texture)
+            return;
+    }
+
+    /* The field is only generated again when one of its inputs changed */
+    if (s->generated && !memcmp(&s->state, &s->last_state, sizeof(s->state)))
+        return;
+
+    for (int i = 0; i < UNIFORM_NB; i++)
+        ngli_pipeline_update_uniform(s->pipeline, s->uniform_indexes[i], get_uniform_data(&s->state, i));
+    if (s->state.texture)
+        ngli_pipeline_update_texture(s->pipeline, s->texture_index, s->state.texture);
+
+    if (!ctx->begin_render_pass) {
+        struct gpu_ctx *gpu_ctx = ctx->gpu_ctx;
+        ngli_gpu_ctx_end_render_pass(gpu_ctx);
+        ctx->current_rendertarget = ctx->available_rendertargets[1];
+        ctx->begin_render_pass = 1;
+    }
+
+    ngli_pipeline_dispatch(s->pipeline, s->nb_groups[0], s->nb_groups[1], 1);
+
+    s->last_state = s->state;
+    s->generated = 1;
+}
+
+static void noisefield_uninit(struct ngl_node *node)
+{
+    struct noisefield_priv *s = node->priv_data;
+
+    ngli_pipeline_freep(&s->pipeline);
+    ngli_pgcraft_freep(&s->crafter);
+    ngli_block_reset(&s->block);
+    if (s->buffer_node) {
+        ngli_node_buffer_unref(s->buffer_node);
+        s->buffer_node = NULL;
+    }
+    s->generated = 0;
+}
+
+const struct node_class ngli_noisefield_class = {
+    .id        = NGL_NODE_NOISEFIELD,
+    .name      = "NoiseField",
+    .init      = noisefield_init,
+    .prepare   = noisefield_prepare,
+    .update    = noisefield_update,
+    .draw      = noisefield_draw,
+    .uninit    = noisefield_uninit,
+    .priv_size = sizeof(struct noisefield_priv),
+    .params    = noisefield_params,
+    .flags     = NGLI_NODE_FLAG_TIME_VARYING,
+    .file      = __FILE__,
+};
@@ -25,6 +25,7 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "path.h"
+#include "pathcache.h"
 
 struct path_priv {
     struct path *path;
@@ -32,6 +33,7 @@ struct path_priv {
     struct ngl_node **keyframes;
     int nb_keyframes;
     int precision;
+    double tolerance;
 };
 
 #define OFFSET(x) offsetof(struct path_priv, x)
@@ -48,6 +50,8 @@ static const struct node_param path_params[] = {
                   .desc=NGLI_DOCSTRING("anchor points the path go through")},
     {"precision", NGLI_PARAM_TYPE_INT, OFFSET(precision), {.i64=64},
                   .desc=NGLI_DOCSTRING("number of divisions per curve segment")},
+    {"tolerance", NGLI_PARAM_TYPE_DBL, OFFSET(tolerance),
+                  .desc=NGLI_DOCSTRING("if not 0, curve segments are adaptively divided so that their arcs do not deviate from the curve by more than this distance, using at most `precision` divisions")},
     {NULL}
 };
 
@@ -84,13 +88,13 @@ static int path_init(struct ngl_node *node)
             return ret;
     }
 
-    return ngli_path_init(s->path, s->precision);
+    return ngli_pathcache_init_path(&node->ctx->pathcache, &s->path, s->precision, s->tolerance);
 }
 
 static void path_uninit(struct ngl_node *node)
 {
     struct path_priv *s = node->priv_data;
-    ngli_path_freep(&s->path);
+    ngli_pathcache_release_path(&node->ctx->pathcache, &s->path, s->precision, s->tolerance);
 }
 
 const struct node_class ngli_path_class = {
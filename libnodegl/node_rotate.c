@@ -87,8 +87,6 @@ static int update_angle(struct ngl_node *node)
 static int rotate_update(struct ngl_node *node, double t)
 {
     struct rotate_priv *s = node->priv_data;
-    struct transform_priv *trf = &s->trf;
-    struct ngl_node *child = trf->child;
     if (s->anim) {
         struct ngl_node *anim_node = s->anim;
         struct variable_priv *anim = anim_node->priv_data;
@@ -97,7 +95,7 @@ static int rotate_update(struct ngl_node *node, double t)
             return ret;
         update_trf_matrix(node, anim->scalar);
     }
-    return ngli_node_update(child, t);
+    return ngli_transform_update(node, t);
 }
 
 #define OFFSET(x) offsetof(struct rotate_priv, x)
@@ -123,10 +121,15 @@ NGLI_STATIC_ASSERT(trf_on_top_of_rotate, OFFSET(trf) == 0);
 
 const struct node_class ngli_rotate_class = {
     .id        = NGL_NODE_ROTATE,
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE,
     .name      = "Rotate",
     .init      = rotate_init,
+    .prepare   = ngli_transform_prepare,
+    .invalidate = ngli_transform_invalidate,
     .update    = rotate_update,
     .draw      = ngli_transform_draw,
+    .compile   = ngli_transform_compile,
+    .uninit    = ngli_transform_uninit,
     .priv_size = sizeof(struct rotate_priv),
     .params    = rotate_params,
     .file      = __FILE__,
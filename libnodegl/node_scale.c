@@ -78,8 +78,6 @@ static int update_factors(struct ngl_node *node)
 static int scale_update(struct ngl_node *node, double t)
 {
     struct scale_priv *s = node->priv_data;
-    struct transform_priv *trf = &s->trf;
-    struct ngl_node *child = trf->child;
     if (s->anim) {
         struct ngl_node *anim_node = s->anim;
         struct variable_priv *anim = anim_node->priv_data;
@@ -88,7 +86,7 @@ static int scale_update(struct ngl_node *node, double t)
             return ret;
         update_trf_matrix(node, anim->vector);
     }
-    return ngli_node_update(child, t);
+    return ngli_transform_update(node, t);
 }
 
 #define OFFSET(x) offsetof(struct scale_priv, x)
@@ -113,10 +111,15 @@ NGLI_STATIC_ASSERT(trf_on_top_of_scale, OFFSET(trf) == 0);
 
 const struct node_class ngli_scale_class = {
     .id        = NGL_NODE_SCALE,
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE,
     .name      = "Scale",
     .init      = scale_init,
+    .prepare   = ngli_transform_prepare,
+    .invalidate = ngli_transform_invalidate,
     .update    = scale_update,
     .draw      = ngli_transform_draw,
+    .compile   = ngli_transform_compile,
+    .uninit    = ngli_transform_uninit,
     .priv_size = sizeof(struct scale_priv),
     .params    = scale_params,
     .file      = __FILE__,
@@ -90,8 +90,6 @@ static int update_angles(struct ngl_node *node)
 static int skew_update(struct ngl_node *node, double t)
 {
     struct skew_priv *s = node->priv_data;
-    struct transform_priv *trf = &s->trf;
-    struct ngl_node *child = trf->child;
     if (s->anim) {
         struct ngl_node *anim_node = s->anim;
         struct variable_priv *anim = anim_node->priv_data;
@@ -100,7 +98,7 @@ static int skew_update(struct ngl_node *node, double t)
             return ret;
         update_trf_matrix(node, anim->vector);
     }
-    return ngli_node_update(child, t);
+    return ngli_transform_update(node, t);
 }
 
 #define OFFSET(x) offsetof(struct skew_priv, x)
@@ -126,10 +124,15 @@ NGLI_STATIC_ASSERT(trf_on_top_of_skew, OFFSET(trf) == 0);
 
 const struct node_class ngli_skew_class = {
     .id        = NGL_NODE_SKEW,
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE,
     .name      = "Skew",
     .init      = skew_init,
+    .prepare   = ngli_transform_prepare,
+    .invalidate = ngli_transform_invalidate,
     .update    = skew_update,
     .draw      = ngli_transform_draw,
+    .compile   = ngli_transform_compile,
+    .uninit    = ngli_transform_uninit,
     .priv_size = sizeof(struct skew_priv),
     .params    = skew_params,
     .file      = __FILE__,
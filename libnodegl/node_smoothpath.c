@@ -26,6 +26,7 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "path.h"
+#include "pathcache.h"
 
 struct smoothpath_priv {
     struct path *path;
@@ -35,6 +36,7 @@ struct smoothpath_priv {
     float control2[3];
     int precision;
     double tension;
+    double tolerance;
 };
 
 #define OFFSET(x) offsetof(struct smoothpath_priv, x)
@@ -51,6 +53,8 @@ static const struct node_param smoothpath_params[] = {
                   .desc=NGLI_DOCSTRING("number of divisions per curve segment")},
     {"tension",   NGLI_PARAM_TYPE_DBL, OFFSET(tension), {.dbl=0.5},
                   .desc=NGLI_DOCSTRING("tension between points")},
+    {"tolerance", NGLI_PARAM_TYPE_DBL, OFFSET(tolerance),
+                  .desc=NGLI_DOCSTRING("if not 0, curve segments are adaptively divided so that their arcs do not deviate from the curve by more than this distance, using at most `precision` divisions")},
     {NULL}
 };
 
@@ -110,13 +114,13 @@ static int smoothpath_init(struct ngl_node *node)
             return ret;
     }
 
-    return ngli_path_init(s->path, s->precision);
+    return ngli_pathcache_init_path(&node->ctx->pathcache, &s->path, s->precision, s->tolerance);
 }
 
 static void smoothpath_uninit(struct ngl_node *node)
 {
     struct smoothpath_priv *s = node->priv_data;
-    ngli_path_freep(&s->path);
+    ngli_pathcache_release_path(&node->ctx->pathcache, &s->path, s->precision, s->tolerance);
 }
 
 const struct node_class ngli_smoothpath_class = {
@@ -27,16 +27,18 @@
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "streamring.h"
 #include "type.h"
+#include "utils.h"
 
 #define OFFSET(x) offsetof(struct variable_priv, x)
 
 #define DECLARE_STREAMED_PARAMS(name, allowed_node)                                                       \
 static const struct node_param streamed##name##_params[] = {                                              \
-    {"timestamps", NGLI_PARAM_TYPE_NODE, OFFSET(timestamps), .flags=NGLI_PARAM_FLAG_NON_NULL,             \
+    {"timestamps", NGLI_PARAM_TYPE_NODE, OFFSET(timestamps),                                              \
                    .node_types=(const int[]){NGL_NODE_BUFFERINT64, -1},                                   \
                    .desc=NGLI_DOCSTRING("timestamps associated with each chunk of data to stream")},      \
-    {"buffer",     NGLI_PARAM_TYPE_NODE, OFFSET(buffer), .flags=NGLI_PARAM_FLAG_NON_NULL,                 \
+    {"buffer",     NGLI_PARAM_TYPE_NODE, OFFSET(buffer),                                                  \
                    .node_types=(const int[]){allowed_node, -1},                                           \
                    .desc=NGLI_DOCSTRING("buffer containing the data to stream")},                         \
     {"timebase",   NGLI_PARAM_TYPE_RATIONAL, OFFSET(timebase), {.r={1, 1000000}},                         \
@@ -44,6 +46,13 @@ static const struct node_param streamed##name##_params[] = {
     {"time_anim",  NGLI_PARAM_TYPE_NODE, OFFSET(time_anim),                                               \
                    .node_types=(const int[]){NGL_NODE_ANIMATEDTIME, -1},                                  \
                    .desc=NGLI_DOCSTRING("time remapping animation (must use a `linear` interpolation)")}, \
+    {"live_capacity", NGLI_PARAM_TYPE_INT, OFFSET(live_capacity),                                         \
+                   .desc=NGLI_DOCSTRING("if not 0, the data is pushed with `ngl_streamed_push()` instead of " \
+                                        "being read from `timestamps` and `buffer`, and at most this "    \
+                                        "number of samples is kept")},                                    \
+    {"live_window", NGLI_PARAM_TYPE_DBL, OFFSET(live_window),                                             \
+                   .desc=NGLI_DOCSTRING("in live mode, samples older than the last one pushed by more "   \
+                                        "than this duration (in seconds) are dropped, 0 to disable")},    \
     {NULL}                                                                                                \
 };
 
@@ -61,20 +70,122 @@ DECLARE_STREAMED_PARAMS(vec3,   NGL_NODE_BUFFERVEC3)
 DECLARE_STREAMED_PARAMS(vec4,   NGL_NODE_BUFFERVEC4)
 DECLARE_STREAMED_PARAMS(mat4,   NGL_NODE_BUFFERMAT4)
 
-static int get_data_index(const struct ngl_node *node, int start, int64_t t64)
+int ngli_streamed_get_data_index(const int64_t *timestamps, int nb_timestamps, int last_index, int64_t t64)
 {
-    const struct variable_priv *s = node->priv_data;
-    const struct buffer_priv *timestamps_priv = s->timestamps->priv_data;
-    const int64_t *timestamps = (int64_t *)timestamps_priv->data;
-    const int nb_timestamps = timestamps_priv->count;
+    int lo = 0, hi = nb_timestamps;
 
-    int ret = -1;
-    for (int i = start; i < nb_timestamps; i++) {
-        const int64_t ts = timestamps[i];
-        if (ts > t64)
-            break;
-        ret = i;
+    /*
+     * Every index below lo has a timestamp lower or equal to t64, and every
+     * index starting at hi has a greater one. During playback, the target is
+     * usually the last index or one of the few following it.
+     */
+    if (last_index < nb_timestamps) {
+        if (timestamps[last_index] <= t64) {
+            lo = last_index + 1;
+            const int probe_end = NGLI_MIN(last_index + 3, nb_timestamps);
+            while (lo < probe_end && timestamps[lo] <= t64)
+                lo++;
+            if (lo < probe_end)
+                return lo - 1;
+        } else {
+            hi = last_index;
+        }
     }
+
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (timestamps[mid] <= t64)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo - 1;
+}
+
+int ngli_streamed_init_live(struct streamring **ringp, int capacity, double window,
+                            const int *timebase, size_t sample_size,
+                            const struct ngl_node *timestamps, const struct ngl_node *buffer)
+{
+    if (capacity < 0 || window < 0) {
+        LOG(ERROR, "invalid live capacity (%d) or window (%g)", capacity, window);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (timestamps || buffer) {
+        LOG(ERROR, "timestamps and buffer can not be set in live mode");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    const int64_t window64 = llrint(window * timebase[1] / (double)timebase[0]);
+    *ringp = ngli_streamring_create(capacity, sample_size, window64);
+    if (!*ringp)
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+static const int live_streamed_ids[] = {
+    NGL_NODE_STREAMEDINT,
+    NGL_NODE_STREAMEDIVEC2,
+    NGL_NODE_STREAMEDIVEC3,
+    NGL_NODE_STREAMEDIVEC4,
+    NGL_NODE_STREAMEDUINT,
+    NGL_NODE_STREAMEDUIVEC2,
+    NGL_NODE_STREAMEDUIVEC3,
+    NGL_NODE_STREAMEDUIVEC4,
+    NGL_NODE_STREAMEDFLOAT,
+    NGL_NODE_STREAMEDVEC2,
+    NGL_NODE_STREAMEDVEC3,
+    NGL_NODE_STREAMEDVEC4,
+    NGL_NODE_STREAMEDMAT4,
+};
+
+static const int live_streamedbuffer_ids[] = {
+    NGL_NODE_STREAMEDBUFFERINT,
+    NGL_NODE_STREAMEDBUFFERIVEC2,
+    NGL_NODE_STREAMEDBUFFERIVEC3,
+    NGL_NODE_STREAMEDBUFFERIVEC4,
+    NGL_NODE_STREAMEDBUFFERUINT,
+    NGL_NODE_STREAMEDBUFFERUIVEC2,
+    NGL_NODE_STREAMEDBUFFERUIVEC3,
+    NGL_NODE_STREAMEDBUFFERUIVEC4,
+    NGL_NODE_STREAMEDBUFFERFLOAT,
+    NGL_NODE_STREAMEDBUFFERVEC2,
+    NGL_NODE_STREAMEDBUFFERVEC3,
+    NGL_NODE_STREAMEDBUFFERVEC4,
+    NGL_NODE_STREAMEDBUFFERMAT4,
+};
+
+static int has_id(const int *ids, int nb_ids, int id)
+{
+    for (int i = 0; i < nb_ids; i++)
+        if (ids[i] == id)
+            return 1;
+    return 0;
+}
+
+int ngl_streamed_push(struct ngl_node *node, int64_t ts, const void *data, int size)
+{
+    struct streamring *ring = NULL;
+    const int id = node->cls->id;
+    if (has_id(live_streamed_ids, NGLI_ARRAY_NB(live_streamed_ids), id)) {
+        const struct variable_priv *s = node->priv_data;
+        ring = s->live_ring;
+    } else if (has_id(live_streamedbuffer_ids, NGLI_ARRAY_NB(live_streamedbuffer_ids), id)) {
+        const struct buffer_priv *s = node->priv_data;
+        ring = s->live_ring;
+    } else {
+        LOG(ERROR, "%s is not a Streamed node", node->label);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (!ring) {
+        LOG(ERROR, "%s is not an initialized live Streamed node", node->label);
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    int ret = ngli_streamring_push(ring, ts, data, size);
+    if (ret < 0)
+        LOG(ERROR, "%s: invalid sample (size=%d, ts=%" PRId64 ")", node->label, size, ts);
     return ret;
 }
 
@@ -107,12 +218,18 @@ static int streamed_update(struct ngl_node *node, double t)
     }
 
     const int64_t t64 = llrint(rt * s->timebase[1] / (double)s->timebase[0]);
-    int index = get_data_index(node, s->last_index, t64);
-    if (index < 0) {
-        index = get_data_index(node, 0, t64);
-        if (index < 0) // the requested time `t` is before the first user timestamp
-            index = 0;
+    if (s->live_ring) {
+        int ret = ngli_streamring_read(s->live_ring, t64, s->data);
+        if (ret < 0)
+            LOG(WARNING, "could not read live data at t=%g, keeping previous value", rt);
+        return 0;
     }
+
+    const struct buffer_priv *timestamps_priv = s->timestamps->priv_data;
+    const int64_t *timestamps = (int64_t *)timestamps_priv->data;
+    int index = ngli_streamed_get_data_index(timestamps, timestamps_priv->count, s->last_index, t64);
+    if (index < 0) // the requested time `t` is before the first user timestamp
+        index = 0;
     s->last_index = index;
 
     const struct buffer_priv *buffer_priv = s->buffer->priv_data;
@@ -166,9 +283,24 @@ static int streamed_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
+    if (s->live_capacity)
+        return ngli_streamed_init_live(&s->live_ring, s->live_capacity, s->live_window,
+                                       s->timebase, s->data_size, s->timestamps, s->buffer);
+
+    if (!s->timestamps || !s->buffer) {
+        LOG(ERROR, "timestamps and buffer must be set when not in live mode");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
     return check_timestamps_buffer(node);
 }
 
+static void streamed_uninit(struct ngl_node *node)
+{
+    struct variable_priv *s = node->priv_data;
+    ngli_streamring_freep(&s->live_ring);
+}
+
 #define DECLARE_STREAMED_INIT(suffix, class_data, class_data_size, class_data_type) \
 static int streamed##suffix##_init(struct ngl_node *node)                           \
 {                                                                                   \
@@ -194,17 +326,19 @@ DECLARE_STREAMED_INIT(vec3,   s->vector,  3 * sizeof(*s->vector),  NGLI_TYPE_VEC
 DECLARE_STREAMED_INIT(vec4,   s->vector,  4 * sizeof(*s->vector),  NGLI_TYPE_VEC4)
 DECLARE_STREAMED_INIT(mat4,   s->matrix,  sizeof(s->matrix),       NGLI_TYPE_MAT4)
 
-#define DECLARE_STREAMED_CLASS(class_id, class_name, class_suffix)          \
-const struct node_class ngli_streamed##class_suffix##_class = {             \
-    .id        = class_id,                                                  \
-    .category  = NGLI_NODE_CATEGORY_UNIFORM,                                \
-    .name      = class_name,                                                \
-    .init      = streamed##class_suffix##_init,                             \
-    .update    = streamed_update,                                           \
-    .priv_size = sizeof(struct variable_priv),                              \
-    .params    = streamed##class_suffix##_params,                           \
-    .file      = __FILE__,                                                  \
-};                                                                          \
+#define DECLARE_STREAMED_CLASS(class_id, class_name, class_suffix)               \
+const struct node_class ngli_streamed##class_suffix##_class = {                  \
+    .id        = class_id,                                                       \
+    .category  = NGLI_NODE_CATEGORY_UNIFORM,                                     \
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE | NGLI_NODE_FLAG_TIME_VARYING, \
+    .name      = class_name,                                                     \
+    .init      = streamed##class_suffix##_init,                                  \
+    .update    = streamed_update,                                                \
+    .uninit    = streamed_uninit,                                                \
+    .priv_size = sizeof(struct variable_priv),                                   \
+    .params    = streamed##class_suffix##_params,                                \
+    .file      = __FILE__,                                                       \
+};                                                                               \
 
 DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDINT,    "StreamedInt",    int)
 DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDIVEC2,  "StreamedIVec2",  ivec2)
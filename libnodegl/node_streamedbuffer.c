@@ -24,9 +24,12 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <string.h>
+#include "format.h"
 #include "log.h"
+#include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "streamring.h"
 #include "type.h"
 
 #define OFFSET(x) offsetof(struct buffer_priv, x)
@@ -35,10 +38,10 @@
 static const struct node_param streamedbuffer##name##_params[] = {                                        \
     {"count",      NGLI_PARAM_TYPE_INT, OFFSET(count),                                                    \
                    .desc=NGLI_DOCSTRING("number of elements for each chunk of data to stream")},          \
-    {"timestamps", NGLI_PARAM_TYPE_NODE, OFFSET(timestamps), .flags=NGLI_PARAM_FLAG_NON_NULL,             \
+    {"timestamps", NGLI_PARAM_TYPE_NODE, OFFSET(timestamps),                                              \
                    .node_types=(const int[]){NGL_NODE_BUFFERINT64, -1},                                   \
                    .desc=NGLI_DOCSTRING("timestamps associated with each chunk of data to stream")},      \
-    {"buffer",     NGLI_PARAM_TYPE_NODE, OFFSET(buffer_node), .flags=NGLI_PARAM_FLAG_NON_NULL,            \
+    {"buffer",     NGLI_PARAM_TYPE_NODE, OFFSET(buffer_node),                                             \
                    .node_types=(const int[]){allowed_node, -1},                                           \
                    .desc=NGLI_DOCSTRING("buffer containing the data to stream")},                         \
     {"timebase",   NGLI_PARAM_TYPE_RATIONAL, OFFSET(timebase), {.r={1, 1000000}},                         \
@@ -46,6 +49,13 @@ static const struct node_param streamedbuffer##name##_params[] = {
     {"time_anim",  NGLI_PARAM_TYPE_NODE, OFFSET(time_anim),                                               \
                    .node_types=(const int[]){NGL_NODE_ANIMATEDTIME, -1},                                  \
                    .desc=NGLI_DOCSTRING("time remapping animation (must use a `linear` interpolation)")}, \
+    {"live_capacity", NGLI_PARAM_TYPE_INT, OFFSET(live_capacity),                                         \
+                   .desc=NGLI_DOCSTRING("if not 0, the chunks are pushed with `ngl_streamed_push()` "     \
+                                        "instead of being read from `timestamps` and `buffer`, and at "   \
+                                        "most this number of chunks is kept")},                           \
+    {"live_window", NGLI_PARAM_TYPE_DBL, OFFSET(live_window),                                             \
+                   .desc=NGLI_DOCSTRING("in live mode, chunks older than the last one pushed by more "    \
+                                        "than this duration (in seconds) are dropped, 0 to disable")},    \
     {NULL}                                                                                                \
 };
 
@@ -63,23 +73,6 @@ DECLARE_STREAMED_PARAMS(vec3,   NGL_NODE_BUFFERVEC3)
 DECLARE_STREAMED_PARAMS(vec4,   NGL_NODE_BUFFERVEC4)
 DECLARE_STREAMED_PARAMS(mat4,   NGL_NODE_BUFFERMAT4)
 
-static int get_data_index(const struct ngl_node *node, int start, int64_t t64)
-{
-    const struct buffer_priv *s = node->priv_data;
-    const struct buffer_priv *timestamps_priv = s->timestamps->priv_data;
-    const int64_t *timestamps = (int64_t *)timestamps_priv->data;
-    const int nb_timestamps = timestamps_priv->count;
-
-    int ret = -1;
-    for (int i = start; i < nb_timestamps; i++) {
-        const int64_t ts = timestamps[i];
-        if (ts > t64)
-            break;
-        ret = i;
-    }
-    return ret;
-}
-
 static int streamedbuffer_update(struct ngl_node *node, double t)
 {
     struct buffer_priv *s = node->priv_data;
@@ -109,12 +102,18 @@ static int streamedbuffer_update(struct ngl_node *node, double t)
     }
 
     const int64_t t64 = llrint(rt * s->timebase[1] / (double)s->timebase[0]);
-    int index = get_data_index(node, s->last_index, t64);
-    if (index < 0) {
-        index = get_data_index(node, 0, t64);
-        if (index < 0) // the requested time `t` is before the first user timestamp
-            index = 0;
+    if (s->live_ring) {
+        int ret = ngli_streamring_read(s->live_ring, t64, s->data);
+        if (ret < 0)
+            LOG(WARNING, "could not read live data at t=%g, keeping previous chunk", rt);
+        return 0;
     }
+
+    const struct buffer_priv *timestamps_priv = s->timestamps->priv_data;
+    const int64_t *timestamps = (int64_t *)timestamps_priv->data;
+    int index = ngli_streamed_get_data_index(timestamps, timestamps_priv->count, s->last_index, t64);
+    if (index < 0) // the requested time `t` is before the first user timestamp
+        index = 0;
     s->last_index = index;
 
     const struct buffer_priv *buffer_priv = s->buffer_node->priv_data;
@@ -159,16 +158,53 @@ static int check_timestamps_buffer(const struct ngl_node *node)
     return 0;
 }
 
+static int streamedbuffer_init_live(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+
+    if (s->data_type == NGLI_TYPE_MAT4) {
+        s->data_comp = 4 * 4;
+        s->data_stride = s->data_comp * sizeof(float);
+    } else {
+        s->data_comp = ngli_format_get_nb_comp(s->data_format);
+        s->data_stride = ngli_format_get_bytes_per_pixel(s->data_format);
+    }
+
+    s->data_size = s->count * s->data_stride;
+    s->data = ngli_calloc(s->count, s->data_stride);
+    if (!s->data)
+        return NGL_ERROR_MEMORY;
+    s->usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT | NGLI_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    return ngli_streamed_init_live(&s->live_ring, s->live_capacity, s->live_window,
+                                   s->timebase, s->data_size, s->timestamps, s->buffer_node);
+}
+
 static int streamedbuffer_init(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
-    struct buffer_priv *buffer_priv = s->buffer_node->priv_data;
 
     if (s->count <= 0) {
         LOG(ERROR, "invalid number of elements (%d <= 0)", s->count);
         return NGL_ERROR_INVALID_ARG;
     }
 
+    if (!s->timebase[1]) {
+        LOG(ERROR, "invalid timebase: %d/%d", s->timebase[0], s->timebase[1]);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    s->dynamic = 1;
+
+    if (s->live_capacity)
+        return streamedbuffer_init_live(node);
+
+    if (!s->timestamps || !s->buffer_node) {
+        LOG(ERROR, "timestamps and buffer must be set when not in live mode");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    struct buffer_priv *buffer_priv = s->buffer_node->priv_data;
     if (buffer_priv->count % s->count) {
         LOG(ERROR, "buffer count (%d) is not a multiple of streamed buffer count (%d)",
             buffer_priv->count, s->count);
@@ -180,30 +216,55 @@ static int streamedbuffer_init(struct ngl_node *node)
     s->data_comp = buffer_priv->data_comp;
     s->data_stride = buffer_priv->data_stride;
     s->usage = buffer_priv->usage;
-    s->data_format = buffer_priv->data_format;
-    s->dynamic = 1;
-    s->data_type = buffer_priv->data_type;
-
-    if (!s->timebase[1]) {
-        LOG(ERROR, "invalid timebase: %d/%d", s->timebase[0], s->timebase[1]);
-        return NGL_ERROR_INVALID_ARG;
-    }
 
     return check_timestamps_buffer(node);
 }
 
+#define DECLARE_STREAMED_INIT(suffix, class_format, class_data_type) \
+static int streamedbuffer##suffix##_init(struct ngl_node *node)      \
+{                                                                    \
+    struct buffer_priv *s = node->priv_data;                         \
+    s->data_format = class_format;                                   \
+    s->data_type = class_data_type;                                  \
+    return streamedbuffer_init(node);                                \
+}                                                                    \
+
+DECLARE_STREAMED_INIT(int,    NGLI_FORMAT_R32_SINT,            NGLI_TYPE_INT)
+DECLARE_STREAMED_INIT(ivec2,  NGLI_FORMAT_R32G32_SINT,         NGLI_TYPE_IVEC2)
+DECLARE_STREAMED_INIT(ivec3,  NGLI_FORMAT_R32G32B32_SINT,      NGLI_TYPE_IVEC3)
+DECLARE_STREAMED_INIT(ivec4,  NGLI_FORMAT_R32G32B32A32_SINT,   NGLI_TYPE_IVEC4)
+DECLARE_STREAMED_INIT(uint,   NGLI_FORMAT_R32_UINT,            NGLI_TYPE_UINT)
+DECLARE_STREAMED_INIT(uivec2, NGLI_FORMAT_R32G32_UINT,         NGLI_TYPE_UIVEC2)
+DECLARE_STREAMED_INIT(uivec3, NGLI_FORMAT_R32G32B32_UINT,      NGLI_TYPE_UIVEC3)
+DECLARE_STREAMED_INIT(uivec4, NGLI_FORMAT_R32G32B32A32_UINT,   NGLI_TYPE_UIVEC4)
+DECLARE_STREAMED_INIT(float,  NGLI_FORMAT_R32_SFLOAT,          NGLI_TYPE_FLOAT)
+DECLARE_STREAMED_INIT(vec2,   NGLI_FORMAT_R32G32_SFLOAT,       NGLI_TYPE_VEC2)
+DECLARE_STREAMED_INIT(vec3,   NGLI_FORMAT_R32G32B32_SFLOAT,    NGLI_TYPE_VEC3)
+DECLARE_STREAMED_INIT(vec4,   NGLI_FORMAT_R32G32B32A32_SFLOAT, NGLI_TYPE_VEC4)
+DECLARE_STREAMED_INIT(mat4,   NGLI_FORMAT_R32G32B32A32_SFLOAT, NGLI_TYPE_MAT4)
+
+static void streamedbuffer_uninit(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+    if (s->live_ring) {
+        ngli_streamring_freep(&s->live_ring);
+        ngli_freep(&s->data);
+    }
+}
 
-#define DECLARE_STREAMED_CLASS(class_id, class_name, class_suffix)          \
-const struct node_class ngli_streamedbuffer##class_suffix##_class = {       \
-    .id        = class_id,                                                  \
-    .category  = NGLI_NODE_CATEGORY_BUFFER,                                 \
-    .name      = class_name,                                                \
-    .init      = streamedbuffer_init,                                       \
-    .update    = streamedbuffer_update,                                     \
-    .priv_size = sizeof(struct buffer_priv),                                \
-    .params    = streamedbuffer##class_suffix##_params,                     \
-    .file      = __FILE__,                                                  \
-};                                                                          \
+#define DECLARE_STREAMED_CLASS(class_id, class_name, class_suffix)               \
+const struct node_class ngli_streamedbuffer##class_suffix##_class = {            \
+    .id        = class_id,                                                       \
+    .category  = NGLI_NODE_CATEGORY_BUFFER,                                      \
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE | NGLI_NODE_FLAG_TIME_VARYING, \
+    .name      = class_name,                                                     \
+    .init      = streamedbuffer##class_suffix##_init,                            \
+    .update    = streamedbuffer_update,                                          \
+    .uninit    = streamedbuffer_uninit,                                          \
+    .priv_size = sizeof(struct buffer_priv),                                     \
+    .params    = streamedbuffer##class_suffix##_params,                          \
+    .file      = __FILE__,                                                       \
+};                                                                               \
 
 DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERINT,    "StreamedBufferInt",    int)
 DECLARE_STREAMED_CLASS(NGL_NODE_STREAMEDBUFFERIVEC2,  "StreamedBufferIVec2",  ivec2)
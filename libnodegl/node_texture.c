@@ -439,6 +439,22 @@ static int get_preferred_format(struct gpu_ctx *gpu_ctx, int format)
     }
 }
 
+static int check_data_src(const struct ngl_node *node)
+{
+    const struct texture_priv *s = node->priv_data;
+    const struct ngl_node *data_src = s->data_src;
+    if (!data_src || data_src->cls->category != NGLI_NODE_CATEGORY_BUFFER)
+        return 0;
+
+    const struct buffer_priv *buffer = data_src->priv_data;
+    if (buffer->gpu_eval) {
+        LOG(ERROR, "%s is evaluated on the GPU and can not be used as a texture data source",
+            data_src->label);
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    return 0;
+}
+
 static int texture2d_init(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -451,6 +467,11 @@ static int texture2d_init(struct ngl_node *node)
             s->params.width, s->params.height, max_dimension, max_dimension);
         return NGL_ERROR_GRAPHICS_UNSUPPORTED;
     }
+
+    int ret = check_data_src(node);
+    if (ret < 0)
+        return ret;
+
     s->params.type = NGLI_TEXTURE_TYPE_2D;
     s->params.format = get_preferred_format(gpu_ctx, s->format);
     s->supported_image_layouts = s->direct_rendering ? -1 : (1 << NGLI_IMAGE_LAYOUT_DEFAULT);
@@ -477,6 +498,11 @@ static int texture3d_init(struct ngl_node *node)
             max_dimension, max_dimension, max_dimension);
         return NGL_ERROR_GRAPHICS_UNSUPPORTED;
     }
+
+    int ret = check_data_src(node);
+    if (ret < 0)
+        return ret;
+
     s->params.type = NGLI_TEXTURE_TYPE_3D;
     s->params.format = get_preferred_format(gpu_ctx, s->format);
 
@@ -501,6 +527,11 @@ static int texturecube_init(struct ngl_node *node)
             s->params.width, s->params.height, max_dimension, max_dimension);
         return NGL_ERROR_GRAPHICS_UNSUPPORTED;
     }
+
+    int ret = check_data_src(node);
+    if (ret < 0)
+        return ret;
+
     s->params.type = NGLI_TEXTURE_TYPE_CUBE;
     s->params.format = get_preferred_format(gpu_ctx, s->format);
 
@@ -23,10 +23,12 @@
 #include <stddef.h>
 #include <string.h>
 
+#include "drawlist.h"
 #include "log.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "params.h"
+#include "utils.h"
 
 struct timerangefilter_priv {
     struct ngl_node *child;
@@ -53,7 +55,7 @@ static const struct node_param timerangefilter_params[] = {
                .flags=NGLI_PARAM_FLAG_DOT_DISPLAY_PACKED,
                .desc=NGLI_DOCSTRING("key frame time filtering events")},
     {"prefetch_time", NGLI_PARAM_TYPE_DBL, OFFSET(prefetch_time), {.dbl=1.0},
-                      .desc=NGLI_DOCSTRING("`child` is prefetched `prefetch_time` seconds in advance")},
+                      .desc=NGLI_DOCSTRING("`child` is prefetched `prefetch_time` seconds in advance, in the background when possible")},
     {"max_idle_time", NGLI_PARAM_TYPE_DBL, OFFSET(max_idle_time), {.dbl=4.0},
                       .desc=NGLI_DOCSTRING("`child` will not be released if it is required in the next incoming `max_idle_time` seconds")},
     {NULL}
@@ -131,6 +133,24 @@ static int update_rr_state(struct timerangefilter_priv *s, double t)
     return rr_id;
 }
 
+double ngli_timerangefilter_get_next_use(const struct ngl_node *node, double t)
+{
+    const struct timerangefilter_priv *s = node->priv_data;
+
+    const int rr_id = get_rr_id(s, 0, t);
+    if (rr_id < 0)
+        return 0.;
+
+    for (int i = rr_id; i < s->nb_ranges; i++) {
+        const struct ngl_node *rr = s->ranges[i];
+        if (rr->cls->id != NGL_NODE_TIMERANGEMODENOOP) {
+            const struct timerangemode_priv *trm = rr->priv_data;
+            return NGLI_MAX(trm->start_time - t, 0.);
+        }
+    }
+    return DBL_MAX;
+}
+
 static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
 {
     struct timerangefilter_priv *s = node->priv_data;
@@ -233,13 +253,27 @@ static void timerangefilter_draw(struct ngl_node *node)
     ngli_node_draw(child);
 }
 
+static int timerangefilter_compile(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct timerangefilter_priv *s = node->priv_data;
+
+    const int branch = ngli_drawlist_begin_branch(drawlist, &s->drawme);
+    if (branch < 0)
+        return branch;
+    int ret = ngli_drawlist_add_node(drawlist, s->child);
+    ngli_drawlist_end_branch(drawlist, branch);
+    return ret;
+}
+
 const struct node_class ngli_timerangefilter_class = {
     .id        = NGL_NODE_TIMERANGEFILTER,
+    .flags     = NGLI_NODE_FLAG_TIME_VARYING,
     .name      = "TimeRangeFilter",
     .init      = timerangefilter_init,
     .visit     = timerangefilter_visit,
     .update    = timerangefilter_update,
     .draw      = timerangefilter_draw,
+    .compile   = timerangefilter_compile,
     .priv_size = sizeof(struct timerangefilter_priv),
     .params    = timerangefilter_params,
     .file      = __FILE__,
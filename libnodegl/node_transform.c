@@ -37,18 +37,16 @@ static const struct node_param transform_params[] = {
     {NULL}
 };
 
-static int transform_update(struct ngl_node *node, double t)
-{
-    struct transform_priv *s = node->priv_data;
-    struct ngl_node *child = s->child;
-    return ngli_node_update(child, t);
-}
-
 const struct node_class ngli_transform_class = {
     .id        = NGL_NODE_TRANSFORM,
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE,
     .name      = "Transform",
-    .update    = transform_update,
+    .prepare   = ngli_transform_prepare,
+    .invalidate = ngli_transform_invalidate,
+    .update    = ngli_transform_update,
     .draw      = ngli_transform_draw,
+    .compile   = ngli_transform_compile,
+    .uninit    = ngli_transform_uninit,
     .priv_size = sizeof(struct transform_priv),
     .params    = transform_params,
     .file      = __FILE__,
@@ -62,8 +62,6 @@ static int translate_init(struct ngl_node *node)
 static int translate_update(struct ngl_node *node, double t)
 {
     struct translate_priv *s = node->priv_data;
-    struct transform_priv *trf = &s->trf;
-    struct ngl_node *child = trf->child;
     if (s->anim) {
         struct ngl_node *anim_node = s->anim;
         struct variable_priv *anim = anim_node->priv_data;
@@ -72,7 +70,7 @@ static int translate_update(struct ngl_node *node, double t)
             return ret;
         update_trf_matrix(node, anim->vector);
     }
-    return ngli_node_update(child, t);
+    return ngli_transform_update(node, t);
 }
 
 #define OFFSET(x) offsetof(struct translate_priv, x)
@@ -94,10 +92,15 @@ NGLI_STATIC_ASSERT(trf_on_top_of_translate, OFFSET(trf) == 0);
 
 const struct node_class ngli_translate_class = {
     .id        = NGL_NODE_TRANSLATE,
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE,
     .name      = "Translate",
     .init      = translate_init,
+    .prepare   = ngli_transform_prepare,
+    .invalidate = ngli_transform_invalidate,
     .update    = translate_update,
     .draw      = ngli_transform_draw,
+    .compile   = ngli_transform_compile,
+    .uninit    = ngli_transform_uninit,
     .priv_size = sizeof(struct translate_priv),
     .params    = translate_params,
     .file      = __FILE__,
@@ -140,6 +140,22 @@ static const struct node_param uniformmat4_params[] = {
 #define uniformuivec3_update NULL
 #define uniformuivec4_update NULL
 
+#define uniformbool_flags   0
+#define uniformfloat_flags  0
+#define uniformvec2_flags   0
+#define uniformvec3_flags   0
+#define uniformvec4_flags   0
+#define uniformquat_flags   NGLI_NODE_FLAG_THREADSAFE_UPDATE
+#define uniformint_flags    0
+#define uniformivec2_flags  0
+#define uniformivec3_flags  0
+#define uniformivec4_flags  0
+#define uniformuint_flags   0
+#define uniformuivec2_flags 0
+#define uniformuivec3_flags 0
+#define uniformuivec4_flags 0
+#define uniformmat4_flags   0 /* the transform chain is drawn on the context matrix stack */
+
 static int uniformquat_update(struct ngl_node *node, double t)
 {
     struct variable_priv *s = node->priv_data;
@@ -239,6 +255,7 @@ static int uniformmat4_init(struct ngl_node *node)
 const struct node_class ngli_uniform##type##_class = {          \
     .id        = class_id,                                      \
     .category  = NGLI_NODE_CATEGORY_UNIFORM,                    \
+    .flags     = uniform##type##_flags,                         \
     .name      = class_name,                                    \
     .init      = uniform##type##_init,                          \
     .update    = uniform##type##_update,                        \
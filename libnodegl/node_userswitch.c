@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 
+#include "drawlist.h"
 #include "nodes.h"
 #include "params.h"
 
@@ -59,12 +60,25 @@ static void userswitch_draw(struct ngl_node *node)
         ngli_node_draw(s->child);
 }
 
+static int userswitch_compile(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct userswitch *s = node->priv_data;
+
+    const int branch = ngli_drawlist_begin_branch(drawlist, &s->enabled);
+    if (branch < 0)
+        return branch;
+    int ret = ngli_drawlist_add_node(drawlist, s->child);
+    ngli_drawlist_end_branch(drawlist, branch);
+    return ret;
+}
+
 const struct node_class ngli_userswitch_class = {
     .id        = NGL_NODE_USERSWITCH,
     .name      = "UserSwitch",
     .visit     = userswitch_visit,
     .update    = userswitch_update,
     .draw      = userswitch_draw,
+    .compile   = userswitch_compile,
     .priv_size = sizeof(struct userswitch),
     .params    = userswitch_params,
     .file      = __FILE__,
@@ -116,8 +116,19 @@ static ngli_animation_cpy_func_type get_cpy_func(int node_class)
     return NULL;
 }
 
+static int get_nb_comps(int node_class)
+{
+    switch (node_class) {
+    case NGL_NODE_VELOCITYFLOAT: return 1;
+    case NGL_NODE_VELOCITYVEC2:  return 2;
+    case NGL_NODE_VELOCITYVEC3:  return 3;
+    case NGL_NODE_VELOCITYVEC4:  return 4;
+    }
+    return 0;
+}
+
 /* Used for standalone evaluation (outside a context) */
-int ngli_velocity_evaluate(struct ngl_node *node, void *dst, double t)
+int ngli_velocity_evaluate(struct ngl_node *node, void *dst, const double *t, int nb_values)
 {
     struct variable_priv *s = node->priv_data;
 
@@ -133,25 +144,39 @@ int ngli_velocity_evaluate(struct ngl_node *node, void *dst, double t)
     if (!anim->nb_animkf)
         return NGL_ERROR_INVALID_ARG;
 
-    if (!s->anim_eval.kfs) {
+    /* Same as ngl_anim_evaluate(), the evaluation state is built once */
+    struct animkeyframe_priv *kf0 = anim->animkf[0]->priv_data;
+    if (!kf0->derivative || s->anim_eval.nb_kfs != anim->nb_animkf) {
+        for (int i = 0; i < anim->nb_animkf; i++) {
+            const struct animkeyframe_priv *kf = anim->animkf[i]->priv_data;
+            if (kf->derivative)
+                continue;
+            int ret = anim->animkf[i]->cls->init(anim->animkf[i]);
+            if (ret < 0)
+                return ret;
+        }
+
+        ngli_animation_reset(&s->anim_eval);
         int ret = ngli_animation_init(&s->anim_eval, NULL,
                                       anim->animkf, anim->nb_animkf,
                                       get_mix_func(node->cls->id),
                                       get_cpy_func(node->cls->id));
         if (ret < 0)
             return ret;
+    } else {
+        int ret = ngli_animation_refresh_times(&s->anim_eval);
+        if (ret < 0)
+            return ret;
     }
 
-    struct animkeyframe_priv *kf0 = anim->animkf[0]->priv_data;
-    if (!kf0->derivative) {
-        for (int i = 0; i < anim->nb_animkf; i++) {
-            int ret = anim->animkf[i]->cls->init(anim->animkf[i]);
-            if (ret < 0)
-                return ret;
-        }
+    float *values = dst;
+    const int nb_comps = get_nb_comps(node->cls->id);
+    for (int i = 0; i < nb_values; i++) {
+        int ret = ngli_animation_derivate(&s->anim_eval, values + i * nb_comps, t[i]);
+        if (ret < 0)
+            return ret;
     }
-
-    return ngli_animation_derivate(&s->anim_eval, dst, t);
+    return 0;
 }
 
 static int velocity_init(struct ngl_node *node)
@@ -171,25 +196,41 @@ static int velocity_update(struct ngl_node *node, double t)
     return ngli_animation_derivate(&s->anim, s->data, t);
 }
 
-#define DEFINE_VELOCITY_CLASS(class_id, class_name, type, dtype, count, dst)    \
-static int velocity##type##_init(struct ngl_node *node)                         \
-{                                                                               \
-    struct variable_priv *s = node->priv_data;                                  \
-    s->data = dst;                                                              \
-    s->data_size = count * sizeof(float);                                       \
-    s->data_type = dtype;                                                       \
-    return velocity_init(node);                                                 \
-}                                                                               \
-                                                                                \
-const struct node_class ngli_velocity##type##_class = {                         \
-    .id        = class_id,                                                      \
-    .category  = NGLI_NODE_CATEGORY_UNIFORM,                                    \
-    .name      = class_name,                                                    \
-    .init      = velocity##type##_init,                                         \
-    .update    = velocity_update,                                               \
-    .priv_size = sizeof(struct variable_priv),                                  \
-    .params    = velocity##type##_params,                                       \
-    .file      = __FILE__,                                                      \
+static void velocity_uninit(struct ngl_node *node)
+{
+    struct variable_priv *s = node->priv_data;
+    ngli_animation_reset(&s->anim);
+    ngli_animation_reset(&s->anim_eval);
+}
+
+static void velocity_free(struct ngl_node *node)
+{
+    struct variable_priv *s = node->priv_data;
+    ngli_animation_reset(&s->anim_eval);
+}
+
+#define DEFINE_VELOCITY_CLASS(class_id, class_name, type, dtype, count, dst)     \
+static int velocity##type##_init(struct ngl_node *node)                          \
+{                                                                                \
+    struct variable_priv *s = node->priv_data;                                   \
+    s->data = dst;                                                               \
+    s->data_size = count * sizeof(float);                                        \
+    s->data_type = dtype;                                                        \
+    return velocity_init(node);                                                  \
+}                                                                                \
+                                                                                 \
+const struct node_class ngli_velocity##type##_class = {                          \
+    .id        = class_id,                                                       \
+    .category  = NGLI_NODE_CATEGORY_UNIFORM,                                     \
+    .flags     = NGLI_NODE_FLAG_THREADSAFE_UPDATE | NGLI_NODE_FLAG_TIME_VARYING, \
+    .name      = class_name,                                                     \
+    .init      = velocity##type##_init,                                          \
+    .update    = velocity_update,                                                \
+    .uninit    = velocity_uninit,                                                \
+    .free      = velocity_free,                                                  \
+    .priv_size = sizeof(struct variable_priv),                                   \
+    .params    = velocity##type##_params,                                        \
+    .file      = __FILE__,                                                       \
 };
 
 DEFINE_VELOCITY_CLASS(NGL_NODE_VELOCITYFLOAT, "VelocityFloat", float, NGLI_TYPE_FLOAT, 1, &s->scalar)
@@ -39,7 +39,8 @@ enum {
     STATE_INIT_FAILED   = -1,
     STATE_UNINITIALIZED = 0, /* post uninit(), default */
     STATE_INITIALIZED   = 1, /* post init() or release() */
-    STATE_READY         = 2, /* post prefetch() */
+    STATE_PREFETCHING   = 2, /* asynchronous prefetch() in progress */
+    STATE_READY         = 3, /* post prefetch() */
 };
 
 /* We depend on the monotonically incrementing by 1 property of these fields */
@@ -80,7 +81,8 @@ static struct ngl_node *node_create(const struct node_class *cls)
 
     node->cls = cls;
     node->last_update_time = -1.;
-    node->visit_time = -1.;
+    node->update_level = -1;
+    node->time_varying = -1;
 
     node->refcount = 1;
 
@@ -156,8 +158,13 @@ struct ngl_node *ngl_node_create(int type)
     return node;
 }
 
-static void node_release(struct ngl_node *node)
+static int node_wait_prefetch(struct ngl_node *node);
+
+void ngli_node_release(struct ngl_node *node)
 {
+    if (node->state == STATE_PREFETCHING)
+        (void)node_wait_prefetch(node);
+
     if (node->state != STATE_READY)
         return;
 
@@ -198,7 +205,7 @@ static void node_uninit(struct ngl_node *node)
     ngli_assert(node->ctx);
     ngli_darray_reset(&node->children);
     ngli_darray_reset(&node->parents);
-    node_release(node);
+    ngli_node_release(node);
 
     if (node->cls->uninit) {
         LOG(VERBOSE, "UNINIT %s @ %p", node->label, node);
@@ -206,7 +213,10 @@ static void node_uninit(struct ngl_node *node)
     }
     reset_non_params(node);
     node->state = STATE_UNINITIALIZED;
-    node->visit_time = -1.;
+    node->is_active = 0;
+    node->visit_epoch = 0;
+    node->invalidate_generation = 0;
+    node->time_varying = -1;
 }
 
 static int track_children(struct ngl_node *node)
@@ -411,6 +421,25 @@ static int node_set_ctx(struct ngl_node *node, struct ngl_ctx *ctx, struct ngl_c
     return 0;
 }
 
+/*
+ * A node is time-varying if its class is, or if any of its children is. The
+ * graph topology can not be changed once attached, so this only needs to be
+ * computed once.
+ */
+static int check_time_varying(struct ngl_node *node)
+{
+    if (node->time_varying >= 0)
+        return node->time_varying;
+
+    int time_varying = !!(node->cls->flags & NGLI_NODE_FLAG_TIME_VARYING);
+    struct darray *children_array = &node->children;
+    struct ngl_node **children = ngli_darray_data(children_array);
+    for (int i = 0; i < ngli_darray_count(children_array); i++)
+        time_varying |= check_time_varying(children[i]);
+    node->time_varying = time_varying;
+    return time_varying;
+}
+
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
 {
     int ret = node_set_ctx(node, ctx, ctx);
@@ -421,6 +450,8 @@ int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx)
     if (ret < 0)
         return ret;
 
+    check_time_varying(node);
+
     return ret;
 }
 
@@ -468,15 +499,24 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t)
     if (!is_active && !node->is_active)
         return 0;
 
-    const int queue_node = node->visit_time != t;
+    struct ngl_ctx *ctx = node->ctx;
+    const int first_visit = node->visit_epoch != ctx->visit_epoch;
+    int queue_node = 0;
 
-    if (queue_node) {
+    if (first_visit) {
         /*
-         * If we never passed through this node for that given time, the new
-         * active state takes over to replace the one from a previous update.
+         * If we never passed through this node during the current visit, the
+         * new active state takes over to replace the one from the previous
+         * visit. Only the nodes flipping their active state need to be
+         * released or prefetched: the later visits can only turn an inactive
+         * node back to active, and such a node is already queued. Active
+         * nodes still waiting for their prefetch are queued as well: a
+         * previous prefetch error may have stopped the processing of the
+         * queue before reaching them.
          */
+        queue_node = node->is_active != is_active || (is_active && ngli_node_needs_prefetch(node));
         node->is_active = is_active;
-        node->visit_time = t;
+        node->visit_epoch = ctx->visit_epoch;
     } else {
         /*
          * This is not the first time we come across that node, so if it's
@@ -501,35 +541,68 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t)
         }
     }
 
-    if (queue_node && !ngli_darray_push(&node->ctx->activitycheck_nodes, &node))
+    if (queue_node && !ngli_darray_push(&ctx->activitycheck_nodes, &node))
         return NGL_ERROR_MEMORY;
 
+    /* The parallel update needs every visited node, not only the changes */
+    if (first_visit && ctx->update_pool && !ngli_darray_push(&ctx->visited_nodes, &node))
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
+static int prefetch_failed(struct ngl_node *node, int ret)
+{
+    LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
+    /* Flag the node as inactive so the prefetch is retried by the next visit */
+    node->is_active = 0;
+    if (node->cls->release) {
+        LOG(VERBOSE, "RELEASE %s @ %p", node->label, node);
+        node->cls->release(node);
+    }
+    node->state = STATE_INITIALIZED;
+    return ret;
+}
+
+static int node_wait_prefetch(struct ngl_node *node)
+{
+    struct prefetcher *prefetcher = node->ctx->prefetcher;
+    int ret = ngli_prefetcher_wait(prefetcher, &node->prefetch_completion);
+    if (ret < 0)
+        return prefetch_failed(node, ret);
+    node->state = STATE_READY;
     return 0;
 }
 
-static int node_prefetch(struct ngl_node *node)
+int ngli_node_prefetch(struct ngl_node *node)
 {
-    if (node->state == STATE_READY)
+    if (node->state == STATE_READY || node->state == STATE_PREFETCHING)
         return 0;
 
     if (node->cls->prefetch) {
+        struct prefetcher *prefetcher = node->ctx->prefetcher;
+        if (prefetcher && (node->cls->flags & NGLI_NODE_FLAG_ASYNC_PREFETCH)) {
+            TRACE("PREFETCH %s @ %p (submitted)", node->label, node);
+            ngli_prefetcher_submit(prefetcher, node, &node->prefetch_completion);
+            node->state = STATE_PREFETCHING;
+            return 0;
+        }
+
         TRACE("PREFETCH %s @ %p", node->label, node);
         int ret = node->cls->prefetch(node);
-        if (ret < 0) {
-            LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
-            node->visit_time = -1.;
-            if (node->cls->release) {
-                LOG(VERBOSE, "RELEASE %s @ %p", node->label, node);
-                node->cls->release(node);
-            }
-            return ret;
-        }
+        if (ret < 0)
+            return prefetch_failed(node, ret);
     }
     node->state = STATE_READY;
 
     return 0;
 }
 
+int ngli_node_needs_prefetch(const struct ngl_node *node)
+{
+    return node->state == STATE_INITIALIZED;
+}
+
 int ngli_node_honor_release_prefetch(struct darray *nodes_array)
 {
     struct ngl_node **nodes = ngli_darray_data(nodes_array);
@@ -537,11 +610,11 @@ int ngli_node_honor_release_prefetch(struct darray *nodes_array)
         struct ngl_node *node = nodes[i];
 
         if (node->is_active) {
-            int ret = node_prefetch(node);
+            int ret = ngli_node_prefetch(node);
             if (ret < 0)
                 return ret;
         } else {
-            node_release(node);
+            ngli_node_release(node);
         }
     }
     return 0;
@@ -549,14 +622,24 @@ int ngli_node_honor_release_prefetch(struct darray *nodes_array)
 
 int ngli_node_update(struct ngl_node *node, double t)
 {
+    if (node->state == STATE_PREFETCHING) {
+        int ret = node_wait_prefetch(node);
+        if (ret < 0)
+            return ret;
+    }
+
     ngli_assert(node->state == STATE_READY);
     if (node->cls->update) {
         if (node->last_update_time != t) {
-            TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
-            int ret = node->cls->update(node, t);
-            if (ret < 0) {
-                LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
-                return ret;
+            if (!node->time_varying && node->last_update_time != -1.) {
+                TRACE("%s is time invariant and up-to-date, skip it", node->label);
+            } else {
+                TRACE("UPDATE %s @ %p with t=%g", node->label, node, t);
+                int ret = node->cls->update(node, t);
+                if (ret < 0) {
+                    LOG(ERROR, "updating node %s failed: %s", node->label, NGLI_RET_STR(ret));
+                    return ret;
+                }
             }
             node->last_update_time = t;
             node->draw_count = 0;
@@ -568,6 +651,145 @@ int ngli_node_update(struct ngl_node *node, double t)
     return 0;
 }
 
+/*
+ * Number of nodes updated by a single job: a node update is usually too cheap
+ * to be worth a job on its own.
+ */
+#define UPDATE_JOB_SIZE 64
+
+struct update_jobs {
+    struct ngl_node **nodes;
+    int nb_nodes;
+    double t;
+};
+
+static int update_job(void *arg, int job_id)
+{
+    const struct update_jobs *jobs = arg;
+    const int start = job_id * UPDATE_JOB_SIZE;
+    const int end = NGLI_MIN(start + UPDATE_JOB_SIZE, jobs->nb_nodes);
+    for (int i = start; i < end; i++) {
+        int ret = ngli_node_update(jobs->nodes[i], jobs->t);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+/*
+ * A node can be updated from the pool if its update is thread-safe and all its
+ * children are eligible as well. Its level is the height of its subtree: all
+ * the nodes of a given level only depend on nodes of the lower levels.
+ */
+static int get_update_level(const struct ngl_node *node)
+{
+    if (!node->is_active || node->state != STATE_READY)
+        return -1;
+    if (node->cls->update && !(node->cls->flags & NGLI_NODE_FLAG_THREADSAFE_UPDATE))
+        return -1;
+
+    int level = 0;
+    const struct darray *children_array = &node->children;
+    struct ngl_node **children = ngli_darray_data(children_array);
+    for (int i = 0; i < ngli_darray_count(children_array); i++) {
+        const struct ngl_node *child = children[i];
+        if (child->update_level < 0)
+            return -1;
+        level = NGLI_MAX(level, child->update_level + 1);
+    }
+    return level;
+}
+
+static int needs_parallel_update(const struct ngl_node *node, double t)
+{
+    return node->update_level >= 0 && node->cls->update && node->last_update_time != t &&
+           (node->time_varying || node->last_update_time == -1.);
+}
+
+static int queue_update_nodes(struct ngl_ctx *ctx, double t)
+{
+    struct darray *nodes_array = &ctx->visited_nodes;
+    struct ngl_node **nodes = ngli_darray_data(nodes_array);
+    const int nb_nodes = ngli_darray_count(nodes_array);
+
+    struct darray *counts_array = &ctx->update_level_counts;
+    ngli_darray_clear(counts_array);
+
+    /*
+     * The visited nodes are queued by ngli_node_visit() after their
+     * children, so the level of the children is always known at this point.
+     */
+    int nb_queued = 0;
+    for (int i = 0; i < nb_nodes; i++) {
+        struct ngl_node *node = nodes[i];
+        node->update_level = get_update_level(node);
+        if (!needs_parallel_update(node, t))
+            continue;
+        while (ngli_darray_count(counts_array) <= node->update_level) {
+            if (!ngli_darray_push(counts_array, &(int){0}))
+                return NGL_ERROR_MEMORY;
+        }
+        int *counts = ngli_darray_data(counts_array);
+        counts[node->update_level]++;
+        nb_queued++;
+    }
+
+    /* Bucket sort the nodes by level, the counts becoming the bucket offsets */
+    struct darray *queue_array = &ctx->update_nodes;
+    ngli_darray_clear(queue_array);
+    for (int i = 0; i < nb_queued; i++)
+        if (!ngli_darray_push(queue_array, NULL))
+            return NGL_ERROR_MEMORY;
+
+    int *counts = ngli_darray_data(counts_array);
+    int offset = 0;
+    for (int i = 0; i < ngli_darray_count(counts_array); i++) {
+        const int count = counts[i];
+        counts[i] = offset;
+        offset += count;
+    }
+
+    struct ngl_node **queue = ngli_darray_data(queue_array);
+    for (int i = 0; i < nb_nodes; i++) {
+        struct ngl_node *node = nodes[i];
+        if (!needs_parallel_update(node, t))
+            continue;
+        queue[counts[node->update_level]++] = node;
+    }
+
+    return 0;
+}
+
+int ngli_node_update_parallel(struct ngl_ctx *ctx, double t)
+{
+    int ret = queue_update_nodes(ctx, t);
+    if (ret < 0)
+        goto end;
+
+    /* After the bucket sort, each count is the end offset of its level */
+    struct ngl_node **queue = ngli_darray_data(&ctx->update_nodes);
+    const int *level_ends = ngli_darray_data(&ctx->update_level_counts);
+    int start = 0;
+    for (int i = 0; i < ngli_darray_count(&ctx->update_level_counts); i++) {
+        struct update_jobs jobs = {
+            .nodes    = queue + start,
+            .nb_nodes = level_ends[i] - start,
+            .t        = t,
+        };
+        const int nb_jobs = (jobs.nb_nodes + UPDATE_JOB_SIZE - 1) / UPDATE_JOB_SIZE;
+        ret = ngli_threadpool_run(ctx->update_pool, update_job, &jobs, nb_jobs);
+        if (ret < 0)
+            goto end;
+        start = level_ends[i];
+    }
+
+end:;
+    struct ngl_node **nodes = ngli_darray_data(&ctx->visited_nodes);
+    for (int i = 0; i < ngli_darray_count(&ctx->visited_nodes); i++)
+        nodes[i]->update_level = -1;
+    return ret;
+}
+
 void ngli_node_draw(struct ngl_node *node)
 {
     if (node->cls->draw) {
@@ -607,6 +829,10 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    /* The queued draws may still be reading the parameters */
+    if (node->ctx)
+        ngli_wait_async_draws(node->ctx);
+
     ret = ngli_params_add(base_ptr, par, nb_elems, elems);
     if (ret < 0) {
         LOG(ERROR, "unable to add elements to %s.%s", node->label, key);
@@ -619,8 +845,15 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
     return ret;
 }
 
-static int node_invalidate_branch(struct ngl_node *node)
+/*
+ * The generation stamp makes sure every ancestor is invalidated once per
+ * sweep, whatever the number of paths leading to it in the graph.
+ */
+static int node_invalidate_branch(struct ngl_node *node, int64_t generation)
 {
+    if (node->invalidate_generation == generation)
+        return 0;
+    node->invalidate_generation = generation;
     node->last_update_time = -1;
     if (node->cls->invalidate) {
         int ret = node->cls->invalidate(node);
@@ -629,13 +862,59 @@ static int node_invalidate_branch(struct ngl_node *node)
     }
     struct ngl_node **parents = ngli_darray_data(&node->parents);
     for (int i = 0; i < ngli_darray_count(&node->parents); i++) {
-        int ret = node_invalidate_branch(parents[i]);
+        int ret = node_invalidate_branch(parents[i], generation);
         if (ret < 0)
             return ret;
     }
     return 0;
 }
 
+static int node_invalidate(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+
+    if (ctx->params_batch) {
+        if (node->params_pending)
+            return 0;
+        if (!ngli_darray_push(&ctx->params_pending_nodes, &node))
+            return NGL_ERROR_MEMORY;
+        node->params_pending = 1;
+        return 0;
+    }
+
+    return node_invalidate_branch(node, ++ctx->invalidate_generation);
+}
+
+int ngl_node_params_begin(struct ngl_ctx *s)
+{
+    /* No asynchronous draw can be queued again until the commit */
+    ngli_wait_async_draws(s);
+    s->params_batch++;
+    return 0;
+}
+
+int ngl_node_params_commit(struct ngl_ctx *s)
+{
+    if (!s->params_batch) {
+        LOG(ERROR, "no parameter changes to commit");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    if (--s->params_batch)
+        return 0;
+
+    int ret = 0;
+    const int64_t generation = ++s->invalidate_generation;
+    struct ngl_node **nodes = ngli_darray_data(&s->params_pending_nodes);
+    for (int i = 0; i < ngli_darray_count(&s->params_pending_nodes); i++) {
+        nodes[i]->params_pending = 0;
+        if (ret >= 0)
+            ret = node_invalidate_branch(nodes[i], generation);
+    }
+    ngli_darray_clear(&s->params_pending_nodes);
+    return ret;
+}
+
 int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
 {
     int ret = 0;
@@ -651,6 +930,10 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    /* The queued draws may still be reading the parameters */
+    if (node->ctx)
+        ngli_wait_async_draws(node->ctx);
+
     va_start(ap, key);
     ret = ngli_params_set(base_ptr, par, &ap);
     va_end(ap);
@@ -665,7 +948,7 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
             if (ret < 0)
                 return ret;
         }
-        ret = node_invalidate_branch(node);
+        ret = node_invalidate(node);
         if (ret < 0)
             return ret;
     }
@@ -690,6 +973,9 @@ void ngl_node_unrefp(struct ngl_node **nodep)
     if (delete) {
         LOG(VERBOSE, "DELETE %s @ %p", node->label, node);
         ngli_assert(!node->ctx);
+        /* Release what was allocated outside of a context, if anything */
+        if (node->cls->free)
+            node->cls->free(node);
         ngli_params_free((uint8_t *)node, ngli_base_node_params);
         ngli_params_free(node->priv_data, node->cls->params);
         ngli_free_aligned(node);
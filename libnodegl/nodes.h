@@ -47,41 +47,70 @@
 #include "hwconv.h"
 #include "hwupload.h"
 #include "image.h"
+#include "lookahead.h"
 #include "nodegl.h"
 #include "params.h"
+#include "pathcache.h"
 #include "pgcache.h"
+#include "prefetcher.h"
 #include "program.h"
 #include "pthread_compat.h"
 #include "darray.h"
 #include "buffer.h"
+#include "buffer_mix.h"
+#include "easing_lut.h"
+#include "easings.h"
+#include "cmdring.h"
 #include "format.h"
 #include "rendertarget.h"
 #include "rnode.h"
+#include "streamring.h"
 #include "texture.h"
+#include "threadpool.h"
 
 struct node_class;
 
 typedef int (*cmd_func_type)(struct ngl_ctx *s, void *arg);
 
+/* One draw in progress on the worker and one queued by the controller */
+#define NGLI_MAX_PENDING_DRAWS 2
+
 struct ngl_ctx {
     /* Controller-only fields */
     int configured;
     pthread_t worker_tid;
+    double pending_draws[NGLI_MAX_PENDING_DRAWS]; /* read by the worker until completion */
+    struct cmdring_completion pending_draws_completions[NGLI_MAX_PENDING_DRAWS];
+    int pending_draws_start;
+    int nb_pending_draws;
+    int async_draw_ret;
+    int64_t invalidate_generation;
+    int params_batch; /* nesting level of ngl_node_params_begin() */
+    struct darray params_pending_nodes; /* nodes waiting for ngl_node_params_commit() */
 
     /* Worker-only fields */
     struct gpu_ctx *gpu_ctx;
     struct rnode rnode;
     struct rnode *rnode_pos;
     struct ngl_node *scene;
+    struct drawlist *drawlist; /* compiled on the first draw of the scene */
     struct ngl_config config;
     struct rendertarget *available_rendertargets[2];
     struct rendertarget *current_rendertarget;
     int begin_render_pass;
     struct darray modelview_matrix_stack;
     struct darray projection_matrix_stack;
-    struct darray activitycheck_nodes;
+    int64_t visit_epoch;
+    struct darray activitycheck_nodes; /* nodes with an activity change during the last visit */
+    struct darray visited_nodes; /* only filled when update_pool is set */
+    struct threadpool *update_pool;
+    struct prefetcher *prefetcher;
+    struct lookahead *lookahead; /* built on the first draw of the scene */
+    struct darray update_nodes;
+    struct darray update_level_counts;
     struct texture *font_atlas;
     struct pgcache pgcache;
+    struct pathcache pathcache;
 #if defined(HAVE_VAAPI)
     struct vaapi_ctx vaapi_ctx;
 #endif
@@ -92,14 +121,10 @@ struct ngl_ctx {
     int64_t cpu_update_time;
     int64_t cpu_draw_time;
     int64_t gpu_draw_time;
+    int64_t upload_size;
 
     /* Shared fields */
-    pthread_mutex_t lock;
-    pthread_cond_t cond_ctl;
-    pthread_cond_t cond_wkr;
-    cmd_func_type cmd_func;
-    void *cmd_arg;
-    int cmd_ret;
+    struct cmdring *cmdring;
 };
 
 struct ngl_node {
@@ -109,11 +134,17 @@ struct ngl_node {
     int state;
     int is_active;
 
-    double visit_time;
+    int64_t visit_epoch;
+    int64_t invalidate_generation; /* last invalidation sweep this node was reached by */
+    int params_pending; /* queued in ctx->params_pending_nodes */
     double last_update_time;
+    int update_level; /* parallel update scheduling, -1 when not eligible */
+    int time_varying; /* -1 until the scene is attached */
 
     int draw_count;
 
+    struct cmdring_completion prefetch_completion; /* in flight when the state is STATE_PREFETCHING */
+
     int refcount;
     int ctx_refcount;
 
@@ -188,15 +219,21 @@ struct buffer_priv {
     /* animatedbuffer */
     struct ngl_node **animkf;
     int nb_animkf;
+    int gpu_eval;
     struct animation anim;
+    struct buffer_mix buffer_mix; /* only used with gpu_eval */
+    int mix_kfs[2];
+    float mix_ratio;
 
     /* streamedbuffer */
     struct ngl_node *timestamps;
     struct ngl_node *buffer_node;
     int timebase[2];
     struct ngl_node *time_anim;
+    int live_capacity;
+    double live_window;
+    struct streamring *live_ring;
 
-    FILE *fp;
     int dynamic;
     int data_type;          // any of NGLI_TYPE_*
     int last_index;
@@ -210,6 +247,7 @@ int ngli_node_buffer_ref(struct ngl_node *node);
 int ngli_node_buffer_init(struct ngl_node *node);
 void ngli_node_buffer_unref(struct ngl_node *node);
 int ngli_node_buffer_upload(struct ngl_node *node);
+int ngli_node_animatedbuffer_mix(struct ngl_node *node);
 
 struct variable_priv {
     union {
@@ -231,9 +269,12 @@ struct variable_priv {
         struct ngl_node *anim_node; /* Velocity nodes only */
         struct ngl_node *path_node; /* AnimatedPath only */
     };
+    int live_capacity;
+    double live_window;
+    struct streamring *live_ring;
 
     struct animation anim;
-    struct animation anim_eval;
+    struct animation anim_eval; /* used by ngl_anim_evaluate() and friends */
     float scalar;
     float vector[4];
     float matrix[4*4];
@@ -250,7 +291,16 @@ struct variable_priv {
     int last_index;
 };
 
-int ngli_velocity_evaluate(struct ngl_node *node, void *dst, double t);
+int ngli_streamed_get_data_index(const int64_t *timestamps, int nb_timestamps, int last_index, int64_t t64);
+int ngli_streamed_init_live(struct streamring **ringp, int capacity, double window,
+                            const int *timebase, size_t sample_size,
+                            const struct ngl_node *timestamps, const struct ngl_node *buffer);
+int ngli_velocity_evaluate(struct ngl_node *node, void *dst, const double *t, int nb_values);
+
+struct block_range {
+    int offset;
+    int size;
+};
 
 struct block_priv {
     struct ngl_node **fields;
@@ -266,7 +316,7 @@ struct block_priv {
 
     struct buffer *buffer;
     int buffer_refcount;
-    int has_changed;
+    struct darray dirty_ranges; /* struct block_range, by increasing offset */
     double buffer_last_upload_time;
 };
 
@@ -289,6 +339,7 @@ struct program_priv {
 
 extern const struct param_choices ngli_mipmap_filter_choices;
 extern const struct param_choices ngli_filter_choices;
+extern const struct param_choices ngli_noise_func_choices;
 
 struct texture_priv {
     int format;
@@ -334,6 +385,7 @@ struct timerangemode_priv {
 struct transform_priv {
     struct ngl_node *child;
     NGLI_ALIGNED_MAT(matrix);
+    struct transform_chain *chain; /* static transforms only, see transforms.c */
 };
 
 struct identity_priv {
@@ -353,53 +405,6 @@ struct resourceprops_priv {
     int variadic;
 };
 
-enum easing_id {
-    EASING_LINEAR,
-    EASING_QUADRATIC_IN,
-    EASING_QUADRATIC_OUT,
-    EASING_QUADRATIC_IN_OUT,
-    EASING_QUADRATIC_OUT_IN,
-    EASING_CUBIC_IN,
-    EASING_CUBIC_OUT,
-    EASING_CUBIC_IN_OUT,
-    EASING_CUBIC_OUT_IN,
-    EASING_QUARTIC_IN,
-    EASING_QUARTIC_OUT,
-    EASING_QUARTIC_IN_OUT,
-    EASING_QUARTIC_OUT_IN,
-    EASING_QUINTIC_IN,
-    EASING_QUINTIC_OUT,
-    EASING_QUINTIC_IN_OUT,
-    EASING_QUINTIC_OUT_IN,
-    EASING_POWER_IN,
-    EASING_POWER_OUT,
-    EASING_POWER_IN_OUT,
-    EASING_POWER_OUT_IN,
-    EASING_SINUS_IN,
-    EASING_SINUS_OUT,
-    EASING_SINUS_IN_OUT,
-    EASING_SINUS_OUT_IN,
-    EASING_EXP_IN,
-    EASING_EXP_OUT,
-    EASING_EXP_IN_OUT,
-    EASING_EXP_OUT_IN,
-    EASING_CIRCULAR_IN,
-    EASING_CIRCULAR_OUT,
-    EASING_CIRCULAR_IN_OUT,
-    EASING_CIRCULAR_OUT_IN,
-    EASING_BOUNCE_IN,
-    EASING_BOUNCE_OUT,
-    EASING_ELASTIC_IN,
-    EASING_ELASTIC_OUT,
-    EASING_BACK_IN,
-    EASING_BACK_OUT,
-    EASING_BACK_IN_OUT,
-    EASING_BACK_OUT_IN,
-};
-
-typedef double easing_type;
-typedef easing_type (*easing_function)(easing_type, int, const easing_type *);
-
 struct animkeyframe_priv {
     double time;
     float value[4];
@@ -416,6 +421,8 @@ struct animkeyframe_priv {
     int scale_boundaries;
     double boundaries[2];
     double derivative_scale;
+    double max_error;
+    struct easing_lut lut;
 };
 
 struct pathkey_move_priv {
@@ -446,11 +453,35 @@ enum {
     NGLI_NODE_CATEGORY_IO,
 };
 
+/*
+ * The update() callback only works on the CPU, and only writes into the node
+ * private data: it can be called from any thread as long as the children were
+ * updated beforehand.
+ */
+#define NGLI_NODE_FLAG_THREADSAFE_UPDATE (1<<0)
+
+/*
+ * The update() callback depends on the time by itself (animations, media,
+ * ...), and not only on the node parameters and children. Nodes without such
+ * a class in their subtree are only updated when (re)initialized or
+ * invalidated by a live change.
+ */
+#define NGLI_NODE_FLAG_TIME_VARYING (1<<1)
+
+/*
+ * The prefetch() callback does not involve any GPU operation and can be
+ * executed on a helper thread. The update() and release() callbacks are not
+ * called before its completion.
+ */
+#define NGLI_NODE_FLAG_ASYNC_PREFETCH (1<<2)
+
+struct drawlist;
+
 /**
  *   Operation        State result
  * -----------------------------------
  * I Init           STATE_INITIALIZED
- * P Prefetch       STATE_READY
+ * P Prefetch       STATE_READY (STATE_PREFETCHING while asynchronous)
  * D Update/Draw
  * R Release        STATE_INITIALIZED
  * U Uninit         STATE_UNINITIALIZED
@@ -478,6 +509,8 @@ enum {
  *  - calling prefetch() will always call init() if necessary
  *  - release() has a weak dependency to prefetch(), so it will noop if not in
  *    the READY state.
+ *  - update() and release() wait for the completion of an asynchronous
+ *    prefetch() (see NGLI_NODE_FLAG_ASYNC_PREFETCH).
  *
  * Note: nodes implementation do NOT have to implement this logic, but they can
  * rely on these properties in their callback implementations.
@@ -485,6 +518,7 @@ enum {
 struct node_class {
     int id;
     int category;
+    int flags;
     const char *name;
     int (*init)(struct ngl_node *node);
     int (*prepare)(struct ngl_node *node);
@@ -493,8 +527,10 @@ struct node_class {
     int (*invalidate)(struct ngl_node *node);
     int (*update)(struct ngl_node *node, double t);
     void (*draw)(struct ngl_node *node);
+    int (*compile)(struct ngl_node *node, struct drawlist *drawlist);
     void (*release)(struct ngl_node *node);
     void (*uninit)(struct ngl_node *node);
+    void (*free)(struct ngl_node *node);
     char *(*info_str)(const struct ngl_node *node);
     size_t priv_size;
     const struct node_param *params;
@@ -507,8 +543,13 @@ void ngli_node_print_specs(void);
 int ngli_node_prepare(struct ngl_node *node);
 int ngli_node_visit(struct ngl_node *node, int is_active, double t);
 int ngli_node_honor_release_prefetch(struct darray *nodes_array);
+int ngli_node_needs_prefetch(const struct ngl_node *node);
+int ngli_node_prefetch(struct ngl_node *node);
+void ngli_node_release(struct ngl_node *node);
 int ngli_node_update(struct ngl_node *node, double t);
+int ngli_node_update_parallel(struct ngl_ctx *ctx, double t);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
+void ngli_wait_async_draws(struct ngl_ctx *s);
 void ngli_node_draw(struct ngl_node *node);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
@@ -519,4 +560,10 @@ int ngli_is_default_label(const char *class_name, const char *str);
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp);
 
+/*
+ * Time in seconds until the child of a TimeRangeFilter is needed for drawing,
+ * 0 if it is currently needed and DBL_MAX if it is never needed again.
+ */
+double ngli_timerangefilter_get_next_use(const struct ngl_node *node, double t);
+
 #endif
@@ -20,6 +20,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "math_utils.h"
 #include "noise.h"
@@ -99,6 +100,13 @@ int ngli_noise_init(struct noise *s, const struct noise_params *params)
     ngli_assert(params->function >= 0 && params->function < NGLI_ARRAY_NB(interp_func_map));
     s->interp_func = interp_func_map[params->function];
     s->params = *params;
+    s->fbm4_params = (struct noise_fbm4_params){
+        .amplitude  = params->amplitude,
+        .lacunarity = params->lacunarity,
+        .gain       = params->gain,
+        .octaves    = params->octaves,
+        .function   = params->function,
+    };
     return 0;
 }
 
@@ -115,3 +123,59 @@ float ngli_noise_get(const struct noise *s, float t)
     }
     return sum;
 }
+
+/*
+ * Same gradient noise as above, in single precision all along so that the
+ * reference matches the SIMD versions as closely as possible
+ */
+void ngli_noise_fbm4_c(float *dst, const float *t, const uint32_t *seeds, const struct noise_fbm4_params *p)
+{
+    const interp_func_type interp_func = interp_func_map[p->function];
+    for (int lane = 0; lane < 4; lane++) {
+        float v = t[lane];
+        float amp = p->amplitude;
+        float sum = 0.f;
+        for (int i = 0; i < p->octaves; i++) {
+            const float fi = floorf(v);
+            const float f = v - fi;
+            const uint32_t x = (uint32_t)(int32_t)fi + seeds[lane];
+            const float s0 = u32tof32(hash(x))     * 2.f - 1.f;
+            const float s1 = u32tof32(hash(x + 1)) * 2.f - 1.f;
+            const float y0 = s0 * f;
+            const float y1 = s1 * (f - 1.f);
+            const float a = interp_func(f);
+            sum += (y0 + (y1 - y0) * a) * amp;
+            v *= p->lacunarity;
+            amp *= p->gain;
+        }
+        dst[lane] = sum;
+    }
+}
+
+void ngli_noise_get_n(const struct noise *s, float *dst, const float *t, int n)
+{
+    const uint32_t seed = s->params.seed;
+    const uint32_t seeds[4] = {seed, seed, seed, seed};
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        ngli_noise_fbm4(dst + i, t + i, seeds, &s->fbm4_params);
+    if (i < n) {
+        float tail_t[4] = {0};
+        float tail_dst[4];
+        memcpy(tail_t, t + i, (n - i) * sizeof(*t));
+        ngli_noise_fbm4(tail_dst, tail_t, seeds, &s->fbm4_params);
+        memcpy(dst + i, tail_dst, (n - i) * sizeof(*dst));
+    }
+}
+
+void ngli_noise_get_vec(const struct noise *s, float *dst, float t, const uint32_t *seeds, int n)
+{
+    ngli_assert(n > 0 && n <= 4);
+    const float lanes_t[4] = {t, t, t, t};
+    uint32_t lanes_seeds[4] = {0};
+    float lanes_dst[4];
+    memcpy(lanes_seeds, seeds, n * sizeof(*seeds));
+    ngli_noise_fbm4(lanes_dst, lanes_t, lanes_seeds, &s->fbm4_params);
+    memcpy(dst, lanes_dst, n * sizeof(*dst));
+}
@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 
+#include "config.h"
+
 enum {
     NGLI_NOISE_LINEAR,
     NGLI_NOISE_CUBIC,
@@ -42,12 +44,55 @@ struct noise_params {
     int function;
 };
 
+/*
+ * Single precision copy of the parameters, laid out for the 4-lane kernels
+ * (the assembly versions rely on this exact layout)
+ */
+struct noise_fbm4_params {
+    float amplitude;
+    float lacunarity;
+    float gain;
+    int octaves;
+    int function;
+};
+
 struct noise {
     struct noise_params params;
     interp_func_type interp_func;
+    struct noise_fbm4_params fbm4_params;
 };
 
 int ngli_noise_init(struct noise *s, const struct noise_params *params);
 float ngli_noise_get(const struct noise *s, float t);
 
+/*
+ * Evaluate the noise at the n times t[] (batched version of ngli_noise_get())
+ */
+void ngli_noise_get_n(const struct noise *s, float *dst, const float *t, int n);
+
+/*
+ * Evaluate the noise at time t for n (up to 4) generators only differing
+ * from s by their seed
+ */
+void ngli_noise_get_vec(const struct noise *s, float *dst, float t, const uint32_t *seeds, int n);
+
+/*
+ * 4-lane fractional Brownian motion kernel: every lane has its own time and
+ * seed, all the octaves are accumulated in one call
+ */
+void ngli_noise_fbm4_c(float *dst, const float *t, const uint32_t *seeds, const struct noise_fbm4_params *p);
+
+/* Arch specific versions */
+
+#ifdef ARCH_AARCH64
+# define ngli_noise_fbm4 ngli_noise_fbm4_aarch64
+#elif defined(ARCH_X86_64)
+# define ngli_noise_fbm4 ngli_noise_fbm4_x86
+#else
+# define ngli_noise_fbm4 ngli_noise_fbm4_c
+#endif
+
+void ngli_noise_fbm4_aarch64(float *dst, const float *t, const uint32_t *seeds, const struct noise_fbm4_params *p);
+void ngli_noise_fbm4_x86(float *dst, const float *t, const uint32_t *seeds, const struct noise_fbm4_params *p);
+
 #endif
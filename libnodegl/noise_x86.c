@@ -0,0 +1,105 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <emmintrin.h>
+
+#include "noise.h"
+
+/* SSE2 has no 32-bit low multiply (pmulld is SSE4.1) */
+static inline __m128i mullo_epi32(__m128i a, __m128i b)
+{
+    const __m128i even = _mm_mul_epu32(a, b);
+    const __m128i odd  = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd,  _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+/* lowbias32, see noise.c */
+static inline __m128i hash(__m128i x)
+{
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = mullo_epi32(x, _mm_set1_epi32(0x7feb352d));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 15));
+    x = mullo_epi32(x, _mm_set1_epi32(0x846ca68b));
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    return x;
+}
+
+/* Random slope in [-1;1) */
+static inline __m128 get_slope(__m128i x)
+{
+    const __m128i bits = _mm_or_si128(_mm_srli_epi32(x, 9), _mm_set1_epi32(0x3f800000));
+    const __m128 v = _mm_castsi128_ps(bits); // [1;2)
+    return _mm_sub_ps(_mm_add_ps(v, v), _mm_set1_ps(3.f));
+}
+
+static inline __m128 interp(__m128 f, int function)
+{
+    switch (function) {
+    case NGLI_NOISE_LINEAR:
+        return f;
+    case NGLI_NOISE_CUBIC: {
+        const __m128 f2 = _mm_mul_ps(f, f);
+        return _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(3.f), _mm_add_ps(f, f)), f2);
+    }
+    default: {
+        const __m128 f3 = _mm_mul_ps(_mm_mul_ps(f, f), f);
+        __m128 r = _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(6.f), f), _mm_set1_ps(15.f));
+        r = _mm_add_ps(_mm_mul_ps(r, f), _mm_set1_ps(10.f));
+        return _mm_mul_ps(r, f3);
+    }
+    }
+}
+
+void ngli_noise_fbm4_x86(float *dst, const float *t, const uint32_t *seeds, const struct noise_fbm4_params *p)
+{
+    const __m128i seed = _mm_loadu_si128((const __m128i *)seeds);
+    const __m128i one_i = _mm_set1_epi32(1);
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 lacunarity = _mm_set1_ps(p->lacunarity);
+    const float gain = p->gain;
+
+    __m128 v = _mm_loadu_ps(t);
+    __m128 sum = _mm_setzero_ps();
+    float amp = p->amplitude;
+    for (int i = 0; i < p->octaves; i++) {
+        /* floor() without SSE4.1: truncate, then fix up the negative values */
+        const __m128i trunc_i = _mm_cvttps_epi32(v);
+        const __m128 trunc = _mm_cvtepi32_ps(trunc_i);
+        const __m128 above = _mm_cmpgt_ps(trunc, v);
+        const __m128i lattice = _mm_add_epi32(trunc_i, _mm_castps_si128(above));
+        const __m128 fi = _mm_sub_ps(trunc, _mm_and_ps(above, one));
+        const __m128 f = _mm_sub_ps(v, fi);
+
+        const __m128i x = _mm_add_epi32(lattice, seed);
+        const __m128 s0 = get_slope(hash(x));
+        const __m128 s1 = get_slope(hash(_mm_add_epi32(x, one_i)));
+        const __m128 y0 = _mm_mul_ps(s0, f);
+        const __m128 y1 = _mm_mul_ps(s1, _mm_sub_ps(f, one));
+        const __m128 a = interp(f, p->function);
+        const __m128 r = _mm_add_ps(y0, _mm_mul_ps(_mm_sub_ps(y1, y0), a));
+
+        sum = _mm_add_ps(sum, _mm_mul_ps(r, _mm_set1_ps(amp)));
+        v = _mm_mul_ps(v, lacunarity);
+        amp *= gain;
+    }
+    _mm_storeu_ps(dst, sum);
+}
@@ -54,6 +54,14 @@ struct pipeline_desc {
 
 static int register_uniform(struct pass *s, const char *name, struct ngl_node *uniform, int stage)
 {
+    if (uniform->cls->category == NGLI_NODE_CATEGORY_BUFFER) {
+        const struct buffer_priv *buffer_priv = uniform->priv_data;
+        if (buffer_priv->gpu_eval) {
+            LOG(ERROR, "%s is evaluated on the GPU and can not be used as a uniform", uniform->label);
+            return NGL_ERROR_INVALID_USAGE;
+        }
+    }
+
     if (!ngli_darray_push(&s->uniform_nodes, &uniform))
         return NGL_ERROR_MEMORY;
 
@@ -19,6 +19,8 @@
  * under the License.
  */
 
+#include <math.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "darray.h"
@@ -34,6 +36,7 @@ struct path_segment {
     float poly_x[4];
     float poly_y[4];
     float poly_z[4];
+    float poly[4][4];       /* interleaved {x,y,z,0} polynomial coefficients */
     int step_start;
     float time_scale;
     uint32_t flags;
@@ -49,7 +52,7 @@ struct path_step {
 
 struct path {
     int precision;
-    int current_arc;            /* cached arc index */
+    float tolerance;
     int *arc_to_segment;        /* map arc indexes to segment indexes */
     struct darray segments;     /* array of struct path_segment */
     struct darray steps;        /* array of struct path_step */
@@ -143,16 +146,42 @@ int ngli_path_bezier3_to(struct path *s, const float *ctl0, const float *ctl1, c
 }
 
 /*
- * Interpolate a 3D point using the polynomials
+ * Interpolate a 3D point using the polynomials. The 3 components are
+ * evaluated together using the interleaved coefficients, which the compiler
+ * is able to map on a single SIMD register.
  */
 static void poly_eval(float *dst, const struct path_segment *segment, float t)
+{
+    const float (*poly)[4] = segment->poly;
+    NGLI_ALIGNED_VEC(v);
+    for (int i = 0; i < 4; i++)
+        v[i] = NGLI_POLY3(poly[0][i], poly[1][i], poly[2][i], poly[3][i], t);
+    memcpy(dst, v, 3 * sizeof(*dst));
+}
+
+/*
+ * Return the number of divisions needed for the arcs of a curve segment to
+ * not deviate from it by more than the tolerance.
+ *
+ * With a uniform division in n steps of the time parameter, the distance
+ * between an arc and the curve is bounded by max|B''(t)| / (8n²) (Wang's
+ * formula). For B(t) = at³ + bt² + ct + d, B''(t) = 6at + 2b is linear in t,
+ * so its max norm over [0;1] is reached at t=0 or t=1.
+ */
+static int get_segment_precision(const struct path_segment *segment, float tolerance, int max_precision)
 {
     const float *x = segment->poly_x;
     const float *y = segment->poly_y;
     const float *z = segment->poly_z;
-    dst[0] = NGLI_POLY3(x[0], x[1], x[2], x[3], t);
-    dst[1] = NGLI_POLY3(y[0], y[1], y[2], y[3], t);
-    dst[2] = NGLI_POLY3(z[0], z[1], z[2], z[3], t);
+    const float d2_start[3] = {2.f * x[1], 2.f * y[1], 2.f * z[1]};
+    const float d2_end[3] = {
+        6.f * x[0] + 2.f * x[1],
+        6.f * y[0] + 2.f * y[1],
+        6.f * z[0] + 2.f * z[1],
+    };
+    const float d2_max = NGLI_MAX(ngli_vec3_length(d2_start), ngli_vec3_length(d2_end));
+    const float n = ceilf(sqrtf(d2_max / (8.f * tolerance)));
+    return (int)NGLI_MAX(NGLI_MIN(n, (float)max_precision), 1.f);
 }
 
 /*
@@ -167,7 +196,8 @@ static void poly_eval(float *dst, const struct path_segment *segment, float t)
  *   coordinate of one segment overlaps with the starting point of the next
  *   segment.
  * - step: a step is a coordinate on the curve; every segment is divided
- *   into an arbitrary number of `precision` steps.
+ *   into an arbitrary number of `precision` steps, or into fewer steps when
+ *   a tolerance is set and the segment is flat enough.
  * - dist: growing distance between the origin of the path up to a given step:
  *   those are approximations of an arc length.
  * - arc: 2 steps form an arc, it represents a (usually small) chunk of a
@@ -178,13 +208,18 @@ static void poly_eval(float *dst, const struct path_segment *segment, float t)
  *   evaluation. With curves, this time is *NOT* correlated with the real clock
  *   time at all. See ngli_path_evaluate() for more information.
  */
-int ngli_path_init(struct path *s, int precision)
+int ngli_path_init(struct path *s, int precision, float tolerance)
 {
     if (precision < 1) {
         LOG(ERROR, "precision must be 1 or superior");
         return NGL_ERROR_INVALID_ARG;
     }
+    if (tolerance < 0.f) {
+        LOG(ERROR, "tolerance must be positive");
+        return NGL_ERROR_INVALID_ARG;
+    }
     s->precision = precision;
+    s->tolerance = tolerance;
 
     const int nb_segments = ngli_darray_count(&s->segments);
     if (nb_segments < 1) {
@@ -201,11 +236,20 @@ int ngli_path_init(struct path *s, int precision)
     for (int i = 0; i < nb_segments; i++) {
         struct path_segment *segment = &segments[i];
 
+        for (int k = 0; k < 4; k++) {
+            segment->poly[k][0] = segment->poly_x[k];
+            segment->poly[k][1] = segment->poly_y[k];
+            segment->poly[k][2] = segment->poly_z[k];
+            segment->poly[k][3] = 0.f;
+        }
+
         /*
          * Compared to curves, straight lines do not need to be divided into
          * small chunks because their length can be calculated exactly.
          */
-        const int precision = (segment->flags & SEGMENT_FLAG_LINE) ? 1 : s->precision;
+        const int precision = (segment->flags & SEGMENT_FLAG_LINE) ? 1
+                            : s->tolerance ? get_segment_precision(segment, s->tolerance, s->precision)
+                            : s->precision;
 
         /*
          * We're not using 1/(P-1) but 1/P for the scale because each segment is
@@ -246,9 +290,14 @@ int ngli_path_init(struct path *s, int precision)
     /*
      * Build the growing distance (from step 0) of steps (including step 0).
      */
-    float total_length = 0.f;
+    /*
+     * The many small arc lengths are accumulated in double precision: in
+     * single precision, the rounding of each addition biases the total
+     * length of long paths with many steps.
+     */
+    double total_length = 0.;
 
-    if (!ngli_darray_push(&s->steps_dist, &total_length))
+    if (!ngli_darray_push(&s->steps_dist, &(float){0.f}))
         return NGL_ERROR_MEMORY;
 
     const struct path_step *steps = ngli_darray_data(&s->steps);
@@ -262,7 +311,7 @@ int ngli_path_init(struct path *s, int precision)
             const float arc_length = ngli_vec3_length(arc_vec);
             total_length += arc_length;
         }
-        if (!ngli_darray_push(&s->steps_dist, &total_length))
+        if (!ngli_darray_push(&s->steps_dist, &(float){total_length}))
             return NGL_ERROR_MEMORY;
     }
 
@@ -280,7 +329,7 @@ int ngli_path_init(struct path *s, int precision)
 
     /* Normalize distances (relative to the total length of the path) */
     float *steps_dist = ngli_darray_data(&s->steps_dist);
-    const float scale = total_length ? 1.f / total_length : 0.f;
+    const float scale = total_length ? 1. / total_length : 0.f;
     for (int i = 0; i < ngli_darray_count(&s->steps_dist); i++)
         steps_dist[i] *= scale;
 
@@ -300,9 +349,8 @@ int ngli_path_init(struct path *s, int precision)
 
 /*
  * Return the index of the vector where `value` belongs, starting the search
- * from index `*cache` (and looping back to 0 if necessary). A vector is
- * defined by 2 consecutive points in the `values` array, with `values`
- * composed of monotonically increasing values.
+ * around index `hint`. A vector is defined by 2 consecutive points in the
+ * `values` array, with `values` composed of monotonically increasing values.
  *
  * The range of the returned index is within [0;nb_values-2].
  *
@@ -318,31 +366,48 @@ int ngli_path_init(struct path *s, int precision)
  *      15    |   3     | after end value, clamped to last index
  *
  */
-static int get_vector_id(const float *values, int nb_values, int *cache, float value)
+static int get_vector_id(const float *values, int nb_values, int hint, float value)
 {
-    int ret = -1;
     const int nb_indexes = nb_values - 1;
-    const int start = *cache;
+    int lo = 0, hi = nb_indexes;
 
-    for (int i = start; i < nb_indexes; i++) {
-        if (values[i] > value)
-            break;
-        ret = i;
-    }
-    if (ret < 0) {
-        for (int i = 0; i < nb_indexes; i++) {
-            if (values[i] > value)
-                break;
-            ret = i;
+    /*
+     * Every index below lo has a value lower or equal to `value`, and every
+     * index starting at hi has a greater one. When evaluating increasing
+     * values, the target is usually close to the hint, so we gallop forward
+     * from it to narrow the range before bisecting.
+     */
+    if (values[hint] <= value) {
+        lo = hint + 1;
+        const int probe_end = NGLI_MIN(hint + 4, nb_indexes);
+        while (lo < probe_end && values[lo] <= value)
+            lo++;
+        if (lo < probe_end)
+            return lo - 1;
+        int probe = lo, step = 4;
+        while (probe < nb_indexes && values[probe] <= value) {
+            lo = probe + 1;
+            probe = lo + step - 1;
+            step <<= 1;
         }
+        hi = NGLI_MIN(probe, nb_indexes);
+    } else {
+        hi = hint;
+    }
+
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (values[mid] <= value)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
+
     /*
-     * We only need to clamp the negative boundary because ret can never reach
+     * We only need to clamp the negative boundary because lo can never exceed
      * nb_indexes, meaning the maximum value is nb_indexes-1, or nb_values-2.
      */
-    ret = NGLI_MAX(ret, 0);
-    *cache = ret;
-    return ret;
+    return NGLI_MAX(lo - 1, 0);
 }
 
 /* Remap x from [c;d] to [a;b] */
@@ -370,11 +435,11 @@ static float remap(float a, float b, float c, float d, float x)
  * https://pomax.github.io/bezierinfo/#arclengthapprox
  * https://pomax.github.io/bezierinfo/#tracing
  */
-void ngli_path_evaluate(struct path *s, float *dst, float distance)
+static int evaluate_arc(const struct path *s, float *dst, int hint, float distance)
 {
     const float *distances = ngli_darray_data(&s->steps_dist);
     const int nb_dists = ngli_darray_count(&s->steps_dist);
-    const int arc_id = get_vector_id(distances, nb_dists, &s->current_arc, distance);
+    const int arc_id = get_vector_id(distances, nb_dists, hint, distance);
     const int segment_id = s->arc_to_segment[arc_id];
     const struct path_segment *segments = ngli_darray_data(&s->segments);
     const struct path_segment *segment = &segments[segment_id];
@@ -386,6 +451,74 @@ void ngli_path_evaluate(struct path *s, float *dst, float distance)
     const float d1 = distances[step1];
     const float t = remap(t0, t1, d0, d1, distance);
     poly_eval(dst, segment, t);
+    return arc_id;
+}
+
+void ngli_path_evaluate(const struct path *s, float *dst, float distance)
+{
+    evaluate_arc(s, dst, 0, distance);
+}
+
+/*
+ * Evaluate n distances at once. Sorting them in increasing order allows the
+ * arc lookup to progress in a single sweep through the distances table, but
+ * is not required.
+ */
+void ngli_path_evaluate_n(const struct path *s, float *dst, const float *distances, int n)
+{
+    int arc_id = 0;
+    for (int i = 0; i < n; i++)
+        arc_id = evaluate_arc(s, dst + i * 3, arc_id, distances[i]);
+}
+
+static uint64_t hash_data(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= p[i];
+        hash *= UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+/*
+ * Only the segments definition is taken into account, which is left untouched
+ * by ngli_path_init(): the hash of a path is the same before and after its
+ * initialization.
+ */
+uint64_t ngli_path_get_hash(const struct path *s, int precision, float tolerance)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+    hash = hash_data(hash, &precision, sizeof(precision));
+    hash = hash_data(hash, &tolerance, sizeof(tolerance));
+    const struct path_segment *segments = ngli_darray_data(&s->segments);
+    for (int i = 0; i < ngli_darray_count(&s->segments); i++) {
+        const struct path_segment *segment = &segments[i];
+        hash = hash_data(hash, segment->poly_x, sizeof(segment->poly_x));
+        hash = hash_data(hash, segment->poly_y, sizeof(segment->poly_y));
+        hash = hash_data(hash, segment->poly_z, sizeof(segment->poly_z));
+        hash = hash_data(hash, &segment->flags, sizeof(segment->flags));
+    }
+    return hash;
+}
+
+int ngli_path_has_same_segments(const struct path *s, const struct path *other)
+{
+    const int nb_segments = ngli_darray_count(&s->segments);
+    if (nb_segments != ngli_darray_count(&other->segments))
+        return 0;
+    const struct path_segment *segments = ngli_darray_data(&s->segments);
+    const struct path_segment *other_segments = ngli_darray_data(&other->segments);
+    for (int i = 0; i < nb_segments; i++) {
+        const struct path_segment *a = &segments[i];
+        const struct path_segment *b = &other_segments[i];
+        if (memcmp(a->poly_x, b->poly_x, sizeof(a->poly_x)) ||
+            memcmp(a->poly_y, b->poly_y, sizeof(a->poly_y)) ||
+            memcmp(a->poly_z, b->poly_z, sizeof(a->poly_z)) ||
+            a->flags != b->flags)
+            return 0;
+    }
+    return 1;
 }
 
 void ngli_path_freep(struct path **sp)
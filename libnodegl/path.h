@@ -22,6 +22,8 @@
 #ifndef PATH_H
 #define PATH_H
 
+#include <stdint.h>
+
 struct path;
 
 struct path *ngli_path_create(void);
@@ -31,9 +33,13 @@ int ngli_path_line_to(struct path *s, const float *to);
 int ngli_path_bezier2_to(struct path *s, const float *ctl, const float *to);
 int ngli_path_bezier3_to(struct path *s, const float *ctl0, const float *ctl1, const float *to);
 
-int ngli_path_init(struct path *s, int precision);
+int ngli_path_init(struct path *s, int precision, float tolerance);
+
+void ngli_path_evaluate(const struct path *s, float *dst, float distance);
+void ngli_path_evaluate_n(const struct path *s, float *dst, const float *distances, int n);
+uint64_t ngli_path_get_hash(const struct path *s, int precision, float tolerance);
+int ngli_path_has_same_segments(const struct path *s, const struct path *other);
 
-void ngli_path_evaluate(struct path *s, float *dst, float distance);
 void ngli_path_freep(struct path **sp);
 
 #endif
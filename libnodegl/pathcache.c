@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "pathcache.h"
+
+struct cached_path {
+    struct path *path;
+    int precision;
+    float tolerance;
+    int refcount;
+};
+
+static void free_cached_path(void *user_arg, void *data)
+{
+    struct cached_path *cached = data;
+    ngli_path_freep(&cached->path);
+    ngli_free(cached);
+}
+
+int ngli_pathcache_init(struct pathcache *s)
+{
+    s->paths = ngli_hmap_create();
+    if (!s->paths)
+        return NGL_ERROR_MEMORY;
+    ngli_hmap_set_free(s->paths, free_cached_path, s);
+    return 0;
+}
+
+#define KEY_SIZE 17
+
+static void get_key(char *key, const struct path *path, int precision, float tolerance)
+{
+    snprintf(key, KEY_SIZE, "%016" PRIx64, ngli_path_get_hash(path, precision, tolerance));
+}
+
+int ngli_pathcache_init_path(struct pathcache *s, struct path **pathp, int precision, float tolerance)
+{
+    struct path *path = *pathp;
+
+    char key[KEY_SIZE];
+    get_key(key, path, precision, tolerance);
+
+    struct cached_path *cached = ngli_hmap_get(s->paths, key);
+    if (cached) {
+        if (cached->precision == precision &&
+            cached->tolerance == tolerance &&
+            ngli_path_has_same_segments(cached->path, path)) {
+            ngli_path_freep(pathp);
+            *pathp = cached->path;
+            cached->refcount++;
+            return 0;
+        }
+
+        /* Hash collision: the path is initialized without being shared */
+        LOG(DEBUG, "path hash collision on %s", key);
+        return ngli_path_init(path, precision, tolerance);
+    }
+
+    int ret = ngli_path_init(path, precision, tolerance);
+    if (ret < 0)
+        return ret;
+
+    cached = ngli_calloc(1, sizeof(*cached));
+    if (!cached)
+        return NGL_ERROR_MEMORY;
+    cached->path = path;
+    cached->precision = precision;
+    cached->tolerance = tolerance;
+    cached->refcount = 1;
+
+    ret = ngli_hmap_set(s->paths, key, cached);
+    if (ret < 0) {
+        ngli_free(cached);
+        return ret;
+    }
+
+    return 0;
+}
+
+void ngli_pathcache_release_path(struct pathcache *s, struct path **pathp, int precision, float tolerance)
+{
+    struct path *path = *pathp;
+    if (!path)
+        return;
+    *pathp = NULL;
+
+    char key[KEY_SIZE];
+    get_key(key, path, precision, tolerance);
+
+    struct cached_path *cached = ngli_hmap_get(s->paths, key);
+    if (!cached || cached->path != path) {
+        ngli_path_freep(&path);
+        return;
+    }
+
+    if (--cached->refcount == 0)
+        ngli_hmap_set(s->paths, key, NULL);
+}
+
+void ngli_pathcache_reset(struct pathcache *s)
+{
+    ngli_hmap_freep(&s->paths);
+}
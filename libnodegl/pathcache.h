@@ -0,0 +1,49 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PATHCACHE_H
+#define PATHCACHE_H
+
+#include "hmap.h"
+#include "path.h"
+
+/*
+ * Cache of initialized paths, shared between the nodes defining identical
+ * curves. Paths are looked up by the content of their segments and their
+ * initialization parameters, and are refcounted by their users.
+ */
+struct pathcache {
+    struct hmap *paths;
+};
+
+int ngli_pathcache_init(struct pathcache *s);
+
+/*
+ * Initialize the path in *pathp, or replace it with a reference to an
+ * identical path already initialized. Paths obtained through this function
+ * must be released with ngli_pathcache_release_path().
+ */
+int ngli_pathcache_init_path(struct pathcache *s, struct path **pathp, int precision, float tolerance);
+void ngli_pathcache_release_path(struct pathcache *s, struct path **pathp, int precision, float tolerance);
+
+void ngli_pathcache_reset(struct pathcache *s);
+
+#endif
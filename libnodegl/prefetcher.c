@@ -0,0 +1,111 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "cmdring.h"
+#include "log.h"
+#include "memory.h"
+#include "nodes.h"
+#include "prefetcher.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+/*
+ * Maximum number of prefetches in flight: when reached, the submission blocks
+ * until the helper thread picks the oldest one
+ */
+#define PREFETCH_RING_SIZE 16
+
+struct prefetcher {
+    struct cmdring *ring;
+    pthread_t tid;
+    int thread_started;
+};
+
+static void *prefetch_thread(void *arg)
+{
+    struct prefetcher *s = arg;
+
+    ngli_thread_set_name("ngl-prefetch");
+
+    for (;;) {
+        struct ngl_node *node;
+        struct cmdring_completion *completion;
+        ngli_cmdring_pop(s->ring, &node, &completion);
+        if (!node) {
+            ngli_cmdring_complete(s->ring, completion, 0);
+            break;
+        }
+        TRACE("PREFETCH %s @ %p (async)", node->label, node);
+        const int ret = node->cls->prefetch(node);
+        ngli_cmdring_complete(s->ring, completion, ret);
+    }
+
+    return NULL;
+}
+
+struct prefetcher *ngli_prefetcher_create(void)
+{
+    struct prefetcher *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->ring = ngli_cmdring_create(PREFETCH_RING_SIZE, sizeof(struct ngl_node *));
+    if (!s->ring) {
+        ngli_prefetcher_freep(&s);
+        return NULL;
+    }
+
+    if (pthread_create(&s->tid, NULL, prefetch_thread, s)) {
+        ngli_prefetcher_freep(&s);
+        return NULL;
+    }
+    s->thread_started = 1;
+
+    return s;
+}
+
+void ngli_prefetcher_submit(struct prefetcher *s, struct ngl_node *node,
+                            struct cmdring_completion *completion)
+{
+    ngli_cmdring_push(s->ring, &node, completion);
+}
+
+int ngli_prefetcher_wait(struct prefetcher *s, struct cmdring_completion *completion)
+{
+    return ngli_cmdring_wait(s->ring, completion);
+}
+
+void ngli_prefetcher_freep(struct prefetcher **sp)
+{
+    struct prefetcher *s = *sp;
+    if (!s)
+        return;
+
+    if (s->thread_started) {
+        struct ngl_node *stop = NULL;
+        struct cmdring_completion completion;
+        ngli_cmdring_push(s->ring, &stop, &completion);
+        ngli_cmdring_wait(s->ring, &completion);
+        pthread_join(s->tid, NULL);
+    }
+    ngli_cmdring_freep(&s->ring);
+    ngli_freep(sp);
+}
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PREFETCHER_H
+#define PREFETCHER_H
+
+#include "cmdring.h"
+
+struct ngl_node;
+
+/*
+ * Helper thread running the prefetch() callback of the node classes flagged
+ * with NGLI_NODE_FLAG_ASYNC_PREFETCH, away from the worker thread. The
+ * submission and the wait must happen on the same thread (the worker).
+ */
+struct prefetcher;
+
+struct prefetcher *ngli_prefetcher_create(void);
+void ngli_prefetcher_submit(struct prefetcher *s, struct ngl_node *node,
+                            struct cmdring_completion *completion);
+int ngli_prefetcher_wait(struct prefetcher *s, struct cmdring_completion *completion);
+void ngli_prefetcher_freep(struct prefetcher **sp);
+
+#endif
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "atomic_compat.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "streamring.h"
+#include "utils.h"
+
+/*
+ * Slots beyond the requested capacity: the producer can push that many
+ * samples while a lookup is running without invalidating it.
+ */
+#define NB_SPARE_SLOTS 16
+#define MAX_READ_ATTEMPTS 16
+
+struct streamring {
+    uint8_t *slots;
+    size_t slot_size;       /* timestamp followed by the sample data */
+    size_t sample_size;
+    unsigned mask;
+    int capacity;
+    int64_t window;
+    int count;              /* number of pushed samples, written by the producer only, accessed atomically */
+    int64_t last_ts;        /* only accessed by the producer */
+};
+
+static uint8_t *get_slot(const struct streamring *s, unsigned index)
+{
+    return s->slots + (index & s->mask) * s->slot_size;
+}
+
+static int64_t get_ts(const struct streamring *s, unsigned index)
+{
+    int64_t ts;
+    memcpy(&ts, get_slot(s, index), sizeof(ts));
+    return ts;
+}
+
+struct streamring *ngli_streamring_create(int capacity, size_t sample_size, int64_t window)
+{
+    ngli_assert(capacity > 0 && window >= 0);
+
+    unsigned nb_slots = 1;
+    while (nb_slots < (unsigned)capacity + NB_SPARE_SLOTS)
+        nb_slots <<= 1;
+
+    struct streamring *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->slot_size = NGLI_ALIGN(sizeof(int64_t) + sample_size, sizeof(int64_t));
+    s->slots = ngli_calloc(nb_slots, s->slot_size);
+    if (!s->slots) {
+        ngli_free(s);
+        return NULL;
+    }
+
+    s->sample_size = sample_size;
+    s->mask = nb_slots - 1;
+    s->capacity = capacity;
+    s->window = window;
+    return s;
+}
+
+int ngli_streamring_push(struct streamring *s, int64_t ts, const void *data, size_t size)
+{
+    if (size != s->sample_size)
+        return NGL_ERROR_INVALID_ARG;
+
+    const unsigned count = s->count;
+    if (count && ts < s->last_ts)
+        return NGL_ERROR_INVALID_ARG;
+
+    /*
+     * The slot may still be read by a lookup validated against the count
+     * published by the previous push: that count must be visible before any
+     * of the following stores overwrite the slot.
+     */
+    ngli_atomic_fence();
+
+    uint8_t *slot = get_slot(s, count);
+    memcpy(slot, &ts, sizeof(ts));
+    memcpy(slot + sizeof(ts), data, s->sample_size);
+    s->last_ts = ts;
+
+    /*
+     * 0 is reserved to the empty state: on wrap around, jump to the next
+     * index mapped on the same slot instead.
+     */
+    unsigned next = count + 1;
+    if (!next)
+        next = s->mask + 1;
+    ngli_atomic_store(&s->count, (int)next);
+    return 0;
+}
+
+int ngli_streamring_read(struct streamring *s, int64_t t, void *data)
+{
+    for (int i = 0; i < MAX_READ_ATTEMPTS; i++) {
+        const unsigned count = ngli_atomic_load(&s->count);
+        if (!count)
+            return 0;
+
+        const int nb = NGLI_MIN(count, (unsigned)s->capacity);
+        const unsigned first = count - nb;
+
+        int lo = 0, hi = nb - 1;
+        if (s->window) {
+            const int64_t min_ts = get_ts(s, first + nb - 1) - s->window;
+            while (lo < hi) {
+                const int mid = lo + (hi - lo) / 2;
+                if (get_ts(s, first + mid) < min_ts)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+        }
+        const int start = lo;
+
+        hi = nb;
+        while (lo < hi) {
+            const int mid = lo + (hi - lo) / 2;
+            if (get_ts(s, first + mid) <= t)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        const int index = NGLI_MAX(lo - 1, start);
+        memcpy(data, get_slot(s, first + index) + sizeof(int64_t), s->sample_size);
+
+        /*
+         * The producer may have been overwriting the slots we just read:
+         * the lookup is only valid if none of them has been reached since
+         * (the slot of the sample currently being written included).
+         */
+        ngli_atomic_fence();
+        const unsigned new_count = ngli_atomic_load(&s->count);
+        if (new_count - first <= s->mask)
+            return 1;
+    }
+
+    /* The producer is pushing faster than a lookup can complete */
+    return NGL_ERROR_LIMIT_EXCEEDED;
+}
+
+void ngli_streamring_freep(struct streamring **sp)
+{
+    struct streamring *s = *sp;
+    if (!s)
+        return;
+    ngli_free(s->slots);
+    ngli_freep(sp);
+}
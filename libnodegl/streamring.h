@@ -0,0 +1,61 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef STREAMRING_H
+#define STREAMRING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Lock-free ring of timestamped samples, written by a single producer and
+ * read by a single consumer.
+ *
+ * The producer never waits: once the ring is full, every new sample evicts
+ * the oldest one. The consumer looks samples up by time without removing
+ * them; since a lookup can race with the eviction of the samples it reads,
+ * it is validated afterwards and retried if needed.
+ */
+
+struct streamring;
+
+/*
+ * Keep the capacity last samples of sample_size bytes. If window is not 0,
+ * samples older than the last one by more than window are also ignored.
+ */
+struct streamring *ngli_streamring_create(int capacity, size_t sample_size, int64_t window);
+
+/*
+ * Producer side: timestamps must be monotonically increasing, and size must
+ * match the sample size of the ring
+ */
+int ngli_streamring_push(struct streamring *s, int64_t ts, const void *data, size_t size);
+
+/*
+ * Consumer side: copy the last sample with a timestamp lower or equal to t,
+ * or the oldest sample if there is none. Return 0 if the ring is empty, 1 if
+ * a sample was copied, or a negative error.
+ */
+int ngli_streamring_read(struct streamring *s, int64_t t, void *data);
+
+void ngli_streamring_freep(struct streamring **sp);
+
+#endif
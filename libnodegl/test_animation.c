@@ -0,0 +1,200 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "animation.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "nodes.h"
+#include "utils.h"
+
+#define NB_KFS 100000
+#define NB_EVALS 200000
+
+static easing_type linear(easing_type t, int nb_args, const easing_type *args)
+{
+    return t;
+}
+
+static void mix_scalar(void *user_arg, void *dst,
+                       const struct animkeyframe_priv *kf0,
+                       const struct animkeyframe_priv *kf1,
+                       double ratio)
+{
+    *(double *)dst = NGLI_MIX(kf0->scalar, kf1->scalar, ratio);
+}
+
+static void cpy_scalar(void *user_arg, void *dst,
+                       const struct animkeyframe_priv *kf)
+{
+    *(double *)dst = kf->scalar;
+}
+
+/* Reference implementation of the linear key frame scan with a cursor */
+static int legacy_get_kf_id(struct ngl_node * const *animkf, int nb_animkf, int start, double t)
+{
+    int ret = -1;
+
+    for (int i = start; i < nb_animkf; i++) {
+        const struct animkeyframe_priv *kf = animkf[i]->priv_data;
+        if (kf->time > t)
+            break;
+        ret = i;
+    }
+    return ret;
+}
+
+/* Reference implementation of the evaluation using the linear scan */
+static void legacy_evaluate(const struct animation *anim, struct ngl_node * const *animkf, int nb_animkf,
+                            int *current_kf, void *dst, double t)
+{
+    int kf_id = legacy_get_kf_id(animkf, nb_animkf, *current_kf, t);
+    if (kf_id < 0)
+        kf_id = legacy_get_kf_id(animkf, nb_animkf, 0, t);
+    if (kf_id >= 0 && kf_id < nb_animkf - 1) {
+        const struct animkeyframe_priv *kf0 = animkf[kf_id    ]->priv_data;
+        const struct animkeyframe_priv *kf1 = animkf[kf_id + 1]->priv_data;
+        const double tnorm = NGLI_LINEAR_INTERP(kf0->time, kf1->time, t);
+        const double ratio = kf1->function(tnorm, kf1->nb_args, kf1->args);
+        *current_kf = kf_id;
+        anim->mix_func(anim->user_arg, dst, kf0, kf1, ratio);
+    } else {
+        const struct animkeyframe_priv *kf0 = animkf[            0]->priv_data;
+        const struct animkeyframe_priv *kfn = animkf[nb_animkf - 1]->priv_data;
+        anim->cpy_func(anim->user_arg, dst, t < kf0->time ? kf0 : kfn);
+    }
+}
+
+static struct ngl_node **create_kfs(int nb_kfs)
+{
+    struct ngl_node **kfs = ngli_calloc(nb_kfs, sizeof(*kfs));
+    ngli_assert(kfs);
+    double time = 0;
+    for (int i = 0; i < nb_kfs; i++) {
+        struct ngl_node *node = ngli_calloc(1, sizeof(*node));
+        struct animkeyframe_priv *kf = ngli_calloc(1, sizeof(*kf));
+        ngli_assert(node && kf);
+        /* Every 7th key frame shares the time of the previous one */
+        if (i % 7)
+            time += 0.5 + (i % 3) * 0.25;
+        kf->time = time;
+        kf->scalar = (i * 37) % 101;
+        kf->function = linear;
+        node->priv_data = kf;
+        kfs[i] = node;
+    }
+    return kfs;
+}
+
+static void free_kfs(struct ngl_node **kfs, int nb_kfs)
+{
+    for (int i = 0; i < nb_kfs; i++) {
+        ngli_free(kfs[i]->priv_data);
+        ngli_free(kfs[i]);
+    }
+    ngli_free(kfs);
+}
+
+static double *create_times(int nb_times, double duration, int sequential)
+{
+    double *times = ngli_calloc(nb_times, sizeof(*times));
+    ngli_assert(times);
+    for (int i = 0; i < nb_times; i++)
+        times[i] = sequential ? (i - 10) * (duration + 20) / nb_times
+                              : rand() / (double)RAND_MAX * (duration + 20) - 10;
+    return times;
+}
+
+static void check_animation(struct ngl_node **kfs, int nb_kfs, const double *times, int nb_times)
+{
+    struct animation anim = {0};
+    ngli_assert(ngli_animation_init(&anim, NULL, kfs, nb_kfs, mix_scalar, cpy_scalar) == 0);
+    int current_kf = 0;
+    for (int i = 0; i < nb_times; i++) {
+        double v, ref;
+        ngli_assert(ngli_animation_evaluate(&anim, &v, times[i]) == 0);
+        legacy_evaluate(&anim, kfs, nb_kfs, &current_kf, &ref, times[i]);
+        if (v != ref) {
+            fprintf(stderr, "t=%g: got %g instead of %g\n", times[i], v, ref);
+            abort();
+        }
+    }
+    ngli_animation_reset(&anim);
+}
+
+static void bench_animation(struct ngl_node **kfs, int nb_kfs, const double *times, int nb_times,
+                            const char *title)
+{
+    struct animation anim = {0};
+    ngli_assert(ngli_animation_init(&anim, NULL, kfs, nb_kfs, mix_scalar, cpy_scalar) == 0);
+    double v, sum = 0, ref_sum = 0;
+
+    const int64_t t0 = ngli_gettime_relative();
+    for (int i = 0; i < nb_times; i++) {
+        ngli_animation_evaluate(&anim, &v, times[i]);
+        sum += v;
+    }
+    const int64_t t1 = ngli_gettime_relative();
+    int current_kf = 0;
+    for (int i = 0; i < nb_times; i++) {
+        legacy_evaluate(&anim, kfs, nb_kfs, &current_kf, &v, times[i]);
+        ref_sum += v;
+    }
+    const int64_t t2 = ngli_gettime_relative();
+
+    printf("%s access: %.1f ns/eval (linear scan: %.1f ns/eval)\n", title,
+           (t1 - t0) * 1000. / nb_times, (t2 - t1) * 1000. / nb_times);
+    ngli_assert(sum == ref_sum);
+    ngli_animation_reset(&anim);
+}
+
+int main(void)
+{
+    /* Small animations exercise the boundaries of the lookups */
+    for (int nb_kfs = 1; nb_kfs < 20; nb_kfs++) {
+        struct ngl_node **kfs = create_kfs(nb_kfs);
+        const double duration = ((struct animkeyframe_priv *)kfs[nb_kfs - 1]->priv_data)->time;
+        for (int sequential = 0; sequential < 2; sequential++) {
+            double *times = create_times(1000, duration, sequential);
+            check_animation(kfs, nb_kfs, times, 1000);
+            ngli_free(times);
+        }
+        free_kfs(kfs, nb_kfs);
+    }
+
+    struct ngl_node **kfs = create_kfs(NB_KFS);
+    const double duration = ((struct animkeyframe_priv *)kfs[NB_KFS - 1]->priv_data)->time;
+    double *seq_times = create_times(NB_EVALS, duration, 1);
+    double *rnd_times = create_times(NB_EVALS / 100, duration, 0);
+
+    check_animation(kfs, NB_KFS, seq_times, NB_EVALS);
+    check_animation(kfs, NB_KFS, rnd_times, NB_EVALS / 100);
+    bench_animation(kfs, NB_KFS, seq_times, NB_EVALS, "sequential");
+    bench_animation(kfs, NB_KFS, rnd_times, NB_EVALS / 100, "random");
+
+    ngli_free(rnd_times);
+    ngli_free(seq_times);
+    free_kfs(kfs, NB_KFS);
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "math_utils.h"
+#include "memory.h"
+#include "utils.h"
+
+#define MAX_ERR 1e-6
+#define BENCH_COUNT (300000 * 4)
+#define BENCH_RUNS 50
+
+/* Reference implementation of the previous AnimatedBuffer mix */
+static void legacy_mix(float *dst, const float *d1, const float *d2, double ratio, int count, int comp)
+{
+    for (int k = 0; k < count; k++)
+        for (int i = 0; i < comp; i++)
+            dst[k*comp + i] = NGLI_MIX(d1[k*comp + i], d2[k*comp + i], ratio);
+}
+
+static float *create_data(int n)
+{
+    float *data = ngli_calloc(n, sizeof(*data));
+    ngli_assert(data);
+    for (int i = 0; i < n; i++)
+        data[i] = (rand() / (float)RAND_MAX - .5f) * 100.f;
+    return data;
+}
+
+typedef void (*mix_func_type)(float *dst, const float *x, const float *y, float a, int n);
+
+static void check_mix(mix_func_type mix_func, const float *d1, const float *d2, int n, double ratio)
+{
+    float *ref = ngli_calloc(n + 1, sizeof(*ref));
+    float *out = ngli_calloc(n + 1, sizeof(*out));
+    ngli_assert(ref && out);
+
+    /* The extra trailing element catches writes past the end */
+    legacy_mix(ref, d1, d2, ratio, n, 1);
+    mix_func(out, d1, d2, ratio, n);
+    for (int i = 0; i < n; i++) {
+        const float err = fabsf(out[i] - ref[i]);
+        const float mag = NGLI_MAX(1.f, NGLI_MAX(fabsf(d1[i]), fabsf(d2[i])));
+        if (err > MAX_ERR * mag) {
+            fprintf(stderr, "n=%d ratio=%g: element %d is %g instead of %g\n", n, ratio, i, out[i], ref[i]);
+            exit(1);
+        }
+    }
+    ngli_assert(out[n] == 0.f);
+
+    ngli_free(out);
+    ngli_free(ref);
+}
+
+static void bench_mix(const float *d1, const float *d2, int n)
+{
+    float *dst = ngli_calloc(n, sizeof(*dst));
+    ngli_assert(dst);
+
+    const int64_t t0 = ngli_gettime_relative();
+    for (int i = 0; i < BENCH_RUNS; i++)
+        legacy_mix(dst, d1, d2, i / (double)BENCH_RUNS, n / 4, 4);
+    const int64_t t1 = ngli_gettime_relative();
+    for (int i = 0; i < BENCH_RUNS; i++)
+        ngli_mix_f32(dst, d1, d2, i / (double)BENCH_RUNS, n);
+    const int64_t t2 = ngli_gettime_relative();
+
+    printf("mix of %d vec4: %.1f us (legacy: %.1f us)\n", n / 4,
+           (t2 - t1) / (double)BENCH_RUNS, (t1 - t0) / (double)BENCH_RUNS);
+    ngli_free(dst);
+}
+
+int main(void)
+{
+    static const double ratios[] = {0., .25, .5, 1. / 3., 1.};
+    static const mix_func_type mix_funcs[] = {ngli_mix_f32_c, ngli_mix_f32};
+
+    float *d1 = create_data(BENCH_COUNT + 3);
+    float *d2 = create_data(BENCH_COUNT + 3);
+
+    /* Every tail size, with all the possible misalignments of the buffers */
+    for (int f = 0; f < NGLI_ARRAY_NB(mix_funcs); f++)
+        for (int offset = 0; offset < 4; offset++)
+            for (int n = 0; n < 67; n++)
+                for (int i = 0; i < NGLI_ARRAY_NB(ratios); i++)
+                    check_mix(mix_funcs[f], d1 + offset, d2 + 3 - offset, n, ratios[i]);
+
+    bench_mix(d1, d2, BENCH_COUNT);
+
+    ngli_free(d2);
+    ngli_free(d1);
+    return 0;
+}
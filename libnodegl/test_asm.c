@@ -19,12 +19,83 @@
  * under the License.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include "utils.h"
 #include "math_utils.h"
 
+#define NB_BENCH_CALLS (1 << 20)
+#define NB_CHILDREN 64
+
+typedef void (*mat4_mul_func)(float *dst, const float *m1, const float *m2);
+typedef void (*mat4_mul_vec4_func)(float *dst, const float *m, const float *v);
+typedef void (*mat3_inverse_func)(float *dst, const float *m);
+
+/*
+ * Every kernel is validated against the C reference and benchmarked, the
+ * AVX variants are skipped if the CPU does not support them.
+ */
+static const struct {
+    const char *name;
+    mat4_mul_func func;
+    int avx;
+} mat4_mul_funcs[] = {
+    {"c", ngli_mat4_mul_c},
+#if defined(ARCH_AARCH64)
+    {"aarch64", ngli_mat4_mul_aarch64},
+#elif defined(ARCH_X86_64)
+    {"avx", ngli_mat4_mul_avx, 1},
+#endif
+};
+
+static const struct {
+    const char *name;
+    mat4_mul_vec4_func func;
+} mat4_mul_vec4_funcs[] = {
+    {"c", ngli_mat4_mul_vec4_c},
+#if defined(ARCH_AARCH64)
+    {"aarch64", ngli_mat4_mul_vec4_aarch64},
+#elif defined(ARCH_X86_64)
+    {"sse2", ngli_mat4_mul_vec4_x86},
+#endif
+};
+
+static const struct {
+    const char *name;
+    mat3_inverse_func func;
+} mat3_inverse_funcs[] = {
+    {"c", ngli_mat3_inverse_c},
+#if defined(ARCH_X86_64)
+    {"sse2", ngli_mat3_inverse_x86},
+#endif
+};
+
+static const NGLI_ALIGNED_MAT(m1) = {
+    0.73016,  0.51184, 0.20930, -7.42311,
+   -9.42693,  1.47287, 0.34995,  0.42049,
+    0.42603, -1.50442, 1.34210,  3.04868,
+    0.53013,  0.68963, 0.25207,  1.96254,
+};
+
+static const NGLI_ALIGNED_MAT(m2) = {
+    0.08222, 0.62387, 0.79754,  0.64541,
+    1.70126, 2.24977, 0.05395, -3.00599,
+    0.30858, 0.90973, 0.84432, -4.01016,
+    6.19681, 5.45165, 0.77647,  0.59262,
+};
+
+static int is_supported(int avx)
+{
+#if defined(ARCH_X86_64)
+    return !avx || ngli_x86_has_avx();
+#else
+    return !avx;
+#endif
+}
+
 static void flt_diff(float *dst, const float *a, const float *b, int size)
 {
     for (int i = 0; i < size; i++)
@@ -42,62 +113,137 @@ static void flt_check(const float *f, int size)
     printf("=> OK\n");
 }
 
-int main(void)
+static void print_bench(const char *name, int64_t t0, int64_t t1, int nb_calls)
 {
-    static const NGLI_ALIGNED_MAT(m1) = {
-        0.73016,  0.51184, 0.20930, -7.42311,
-       -9.42693,  1.47287, 0.34995,  0.42049,
-        0.42603, -1.50442, 1.34210,  3.04868,
-        0.53013,  0.68963, 0.25207,  1.96254,
-    };
-
-    static const NGLI_ALIGNED_MAT(m2) = {
-        0.08222, 0.62387, 0.79754,  0.64541,
-        1.70126, 2.24977, 0.05395, -3.00599,
-        0.30858, 0.90973, 0.84432, -4.01016,
-        6.19681, 5.45165, 0.77647,  0.59262,
-    };
+    printf("%-8s %6.2f ns/call\n", name, (t1 - t0) * 1000. / nb_calls);
+}
 
-    printf("m1:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m1));
-    printf("m2:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m2));
+static void test_mat4_mul(const char *name, mat4_mul_func func)
+{
+    printf(":: Testing mat4 mul (%s)\n", name);
+
+    NGLI_ALIGNED_MAT(m_ref);
+    NGLI_ALIGNED_MAT(m_out) = {0};
+    NGLI_ALIGNED_MAT(m_diff);
+
+    ngli_mat4_mul_c(m_ref, m1, m2);
+    func(m_out, m1, m2);
+    flt_diff(m_diff, m_ref, m_out, 4*4);
+
+    printf("ref:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_ref));
+    printf("out:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_out));
+    printf("diff:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_diff));
+    flt_check(m_diff, 4*4);
+
+    /* In place, as done by the transform nodes */
+    memcpy(m_out, m2, sizeof(m_out));
+    func(m_out, m1, m_out);
+    flt_diff(m_diff, m_ref, m_out, 4*4);
+    flt_check(m_diff, 4*4);
+}
 
-    if (ngli_mat4_mul_c != ngli_mat4_mul) {
-        printf(":: Testing mat4 mul\n");
+static void test_mat4_mul_vec4(const char *name, mat4_mul_vec4_func func)
+{
+    for (int i = 0; i < 4; i++) {
+        printf(":: Testing mat4 mul vec4 %d/4 (%s)\n", i + 1, name);
+
+        const float *v = &m2[i * 4];
 
-        NGLI_ALIGNED_MAT(m_ref);
-        NGLI_ALIGNED_MAT(m_out) = {0};
-        NGLI_ALIGNED_MAT(m_diff);
+        NGLI_ALIGNED_VEC(v_ref);
+        NGLI_ALIGNED_VEC(v_out) = {0};
+        NGLI_ALIGNED_VEC(v_diff);
 
-        ngli_mat4_mul_c(m_ref, m1, m2);
-        ngli_mat4_mul(m_out, m1, m2);
-        flt_diff(m_diff, m_ref, m_out, 4*4);
+        ngli_mat4_mul_vec4_c(v_ref, m1, v);
+        func(v_out, m1, v);
+        flt_diff(v_diff, v_ref, v_out, 4);
 
-        printf("ref:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_ref));
-        printf("out:\n"  NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_out));
-        printf("diff:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m_diff));
-        flt_check(m_diff, 4*4);
+        printf("ref:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_ref));
+        printf("out:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_out));
+        printf("diff: " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_diff));
+        flt_check(v_diff, 4);
     }
+}
 
-    if (ngli_mat4_mul_vec4_c != ngli_mat4_mul_vec4) {
-        for (int i = 0; i < 4; i++) {
-            printf(":: Testing mat4 mul vec4 %d/4\n", i + 1);
+static void test_mat3_inverse(const char *name, mat3_inverse_func func)
+{
+    printf(":: Testing mat3 inverse (%s)\n", name);
+
+    float m[3*3], m_ref[3*3], m_out[3*3], m_diff[3*3];
+    ngli_mat3_from_mat4(m, m1);
+
+    ngli_mat3_inverse_c(m_ref, m);
+    memcpy(m_out, m, sizeof(m_out));
+    func(m_out, m_out);
+    flt_diff(m_diff, m_ref, m_out, 3*3);
+    flt_check(m_diff, 3*3);
+
+    /* A singular matrix is returned unchanged */
+    static const float singular[3*3] = {1, 2, 3, 2, 4, 6, 0, 1, 0};
+    func(m_out, singular);
+    flt_diff(m_diff, singular, m_out, 3*3);
+    flt_check(m_diff, 3*3);
+}
 
-            const float *v = &m2[i * 4];
+static void bench(const float *children)
+{
+    static float NGLI_ATTR_ALIGNED m_out[NB_CHILDREN][4*4];
+
+    printf(":: Benchmarking mat4 mul\n");
+    for (int i = 0; i < NGLI_ARRAY_NB(mat4_mul_funcs); i++) {
+        if (!is_supported(mat4_mul_funcs[i].avx))
+            continue;
+        const mat4_mul_func func = mat4_mul_funcs[i].func;
+        const int64_t t0 = ngli_gettime_relative();
+        for (int n = 0; n < NB_BENCH_CALLS; n++)
+            func(m_out[n % NB_CHILDREN], m1, children + (n % NB_CHILDREN) * 4 * 4);
+        print_bench(mat4_mul_funcs[i].name, t0, ngli_gettime_relative(), NB_BENCH_CALLS);
+    }
 
-            NGLI_ALIGNED_VEC(v_ref);
-            NGLI_ALIGNED_VEC(v_out) = {0};
-            NGLI_ALIGNED_VEC(v_diff);
+    printf(":: Benchmarking mat4 mul vec4\n");
+    for (int i = 0; i < NGLI_ARRAY_NB(mat4_mul_vec4_funcs); i++) {
+        const mat4_mul_vec4_func func = mat4_mul_vec4_funcs[i].func;
+        const int64_t t0 = ngli_gettime_relative();
+        for (int n = 0; n < NB_BENCH_CALLS; n++)
+            func(m_out[0] + (n % 4) * 4, m1, m2 + (n % 4) * 4);
+        print_bench(mat4_mul_vec4_funcs[i].name, t0, ngli_gettime_relative(), NB_BENCH_CALLS);
+    }
 
-            ngli_mat4_mul_vec4_c(v_ref, m1, v);
-            ngli_mat4_mul_vec4(v_out, m1, v);
-            flt_diff(v_diff, v_ref, v_out, 4);
+    printf(":: Benchmarking mat3 inverse\n");
+    float m[3*3];
+    ngli_mat3_from_mat4(m, m1);
+    for (int i = 0; i < NGLI_ARRAY_NB(mat3_inverse_funcs); i++) {
+        const mat3_inverse_func func = mat3_inverse_funcs[i].func;
+        const int64_t t0 = ngli_gettime_relative();
+        for (int n = 0; n < NB_BENCH_CALLS; n++)
+            func(m_out[n % NB_CHILDREN], m);
+        print_bench(mat3_inverse_funcs[i].name, t0, ngli_gettime_relative(), NB_BENCH_CALLS);
+    }
+}
 
-            printf("ref:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_ref));
-            printf("out:  " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_out));
-            printf("diff: " NGLI_FMT_VEC4 "\n", NGLI_ARG_VEC4(v_diff));
-            flt_check(v_diff, 4);
-        }
+int main(void)
+{
+    printf("m1:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m1));
+    printf("m2:\n" NGLI_FMT_MAT4 "\n", NGLI_ARG_MAT4(m2));
+
+    /* Children made of shifted copies of m1 and m2 */
+    static float NGLI_ATTR_ALIGNED children[NB_CHILDREN][4*4];
+    for (int i = 0; i < NB_CHILDREN; i++) {
+        const float *src = i & 1 ? m1 : m2;
+        for (int j = 0; j < 4 * 4; j++)
+            children[i][j] = src[(j + i) % (4 * 4)];
     }
 
+    for (int i = 1; i < NGLI_ARRAY_NB(mat4_mul_funcs); i++)
+        if (is_supported(mat4_mul_funcs[i].avx))
+            test_mat4_mul(mat4_mul_funcs[i].name, mat4_mul_funcs[i].func);
+
+    for (int i = 1; i < NGLI_ARRAY_NB(mat4_mul_vec4_funcs); i++)
+        test_mat4_mul_vec4(mat4_mul_vec4_funcs[i].name, mat4_mul_vec4_funcs[i].func);
+
+    for (int i = 1; i < NGLI_ARRAY_NB(mat3_inverse_funcs); i++)
+        test_mat3_inverse(mat3_inverse_funcs[i].name, mat3_inverse_funcs[i].func);
+
+    bench(children[0]);
+
     return 0;
 }
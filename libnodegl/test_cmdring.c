@@ -0,0 +1,167 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "cmdring.h"
+#include "pthread_compat.h"
+#include "utils.h"
+
+#define NB_CMDS 20000
+#define RING_SIZE 8
+
+struct cmd {
+    int value;
+    int stop;
+};
+
+static void *consumer_thread(void *arg)
+{
+    struct cmdring *ring = arg;
+    for (;;) {
+        struct cmd cmd;
+        struct cmdring_completion *completion;
+        ngli_cmdring_pop(ring, &cmd, &completion);
+        ngli_cmdring_complete(ring, completion, cmd.value * 2);
+        if (cmd.stop)
+            break;
+    }
+    return NULL;
+}
+
+/* Reference implementation of the single slot mutex/cond handshake */
+struct legacy {
+    pthread_mutex_t lock;
+    pthread_cond_t cond_ctl;
+    pthread_cond_t cond_wkr;
+    const struct cmd *cmd;
+    int ret;
+};
+
+static void *legacy_thread(void *arg)
+{
+    struct legacy *s = arg;
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->cmd)
+            pthread_cond_wait(&s->cond_wkr, &s->lock);
+        s->ret = s->cmd->value * 2;
+        const int stop = s->cmd->stop;
+        s->cmd = NULL;
+        pthread_cond_signal(&s->cond_ctl);
+        if (stop)
+            break;
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+static int legacy_dispatch(struct legacy *s, const struct cmd *cmd)
+{
+    pthread_mutex_lock(&s->lock);
+    s->cmd = cmd;
+    pthread_cond_signal(&s->cond_wkr);
+    while (s->cmd)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+    return s->ret;
+}
+
+static int ring_dispatch(struct cmdring *ring, const struct cmd *cmd)
+{
+    struct cmdring_completion completion;
+    ngli_cmdring_push(ring, cmd, &completion);
+    return ngli_cmdring_wait(ring, &completion);
+}
+
+static double get_rate(int64_t t0, int64_t t1)
+{
+    return NB_CMDS / ((t1 - t0) / 1000000.);
+}
+
+static void bench_legacy(void)
+{
+    struct legacy s = {0};
+    pthread_t tid;
+    ngli_assert(!pthread_mutex_init(&s.lock, NULL));
+    ngli_assert(!pthread_cond_init(&s.cond_ctl, NULL));
+    ngli_assert(!pthread_cond_init(&s.cond_wkr, NULL));
+    ngli_assert(!pthread_create(&tid, NULL, legacy_thread, &s));
+
+    const int64_t t0 = ngli_gettime_relative();
+    for (int i = 0; i < NB_CMDS; i++) {
+        const struct cmd cmd = {.value = i};
+        ngli_assert(legacy_dispatch(&s, &cmd) == i * 2);
+    }
+    const int64_t t1 = ngli_gettime_relative();
+    printf("mutex/cond: %.0f cmd/s\n", get_rate(t0, t1));
+
+    legacy_dispatch(&s, &(const struct cmd){.stop = 1});
+    pthread_join(tid, NULL);
+    pthread_cond_destroy(&s.cond_wkr);
+    pthread_cond_destroy(&s.cond_ctl);
+    pthread_mutex_destroy(&s.lock);
+}
+
+static void test_cmdring(void)
+{
+    struct cmdring *ring = ngli_cmdring_create(RING_SIZE, sizeof(struct cmd));
+    ngli_assert(ring);
+    pthread_t tid;
+    ngli_assert(!pthread_create(&tid, NULL, consumer_thread, ring));
+
+    /* Synchronous round trips */
+    const int64_t t0 = ngli_gettime_relative();
+    for (int i = 0; i < NB_CMDS; i++) {
+        const struct cmd cmd = {.value = i};
+        ngli_assert(ring_dispatch(ring, &cmd) == i * 2);
+    }
+    const int64_t t1 = ngli_gettime_relative();
+    printf("cmdring: %.0f cmd/s\n", get_rate(t0, t1));
+
+    /* Pipelined commands, more than the ring can hold at once */
+    struct cmdring_completion completions[RING_SIZE * 4];
+    for (int i = 0; i < NGLI_ARRAY_NB(completions); i++) {
+        const struct cmd cmd = {.value = i};
+        ngli_cmdring_push(ring, &cmd, &completions[i]);
+    }
+    for (int i = 0; i < NGLI_ARRAY_NB(completions); i++)
+        ngli_assert(ngli_cmdring_wait(ring, &completions[i]) == i * 2);
+
+    /* Commands without completion are executed in order with the others */
+    for (int i = 0; i < RING_SIZE * 4; i++)
+        ngli_cmdring_push(ring, &(const struct cmd){.value = i}, NULL);
+    ngli_assert(ring_dispatch(ring, &(const struct cmd){.value = 21}) == 42);
+    ngli_assert(ngli_cmdring_poll(ring, &completions[0]));
+
+    ring_dispatch(ring, &(const struct cmd){.stop = 1});
+    pthread_join(tid, NULL);
+    ngli_cmdring_freep(&ring);
+    ngli_assert(!ring);
+}
+
+int main(void)
+{
+    test_cmdring();
+    bench_legacy();
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "easing_lut.h"
+#include "easings.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "utils.h"
+
+#define NB_EVALS (1 << 20)
+
+/* The reference values are computed with the easings of the AnimKeyFrame nodes */
+struct test_easing {
+    const char *name;
+    enum easing_id id;
+    const double *args;
+    int nb_args;
+};
+
+static double eval_easing(const void *arg, double t)
+{
+    const struct test_easing *easing = arg;
+    return ngli_easing_get(easing->id)->function(t, easing->nb_args, easing->args);
+}
+
+static const double back_args[] = {1.70158};
+
+static const struct {
+    struct test_easing easing;
+    double min_error;
+} easings[] = {
+    {{"sinus_in", EASING_SINUS_IN}},
+    {{"exp_in", EASING_EXP_IN}},
+    /* Discontinuous at t=0, where it jumps from 0 to about 2^-10 */
+    {{"elastic_in", EASING_ELASTIC_IN}, 1e-3},
+    /* The slope changes abruptly at each bounce, which requires many intervals */
+    {{"bounce_out", EASING_BOUNCE_OUT}, 1e-4},
+    {{"back_in", EASING_BACK_IN, back_args, NGLI_ARRAY_NB(back_args)}},
+};
+
+/* Infinite slope at t=1: can not be approximated with a reasonable table */
+static const struct test_easing circular_in = {"circular_in", EASING_CIRCULAR_IN};
+
+static const double max_errors[] = {1e-2, 1e-3, 1e-4, 1e-5, 1e-6};
+
+static void check_error(const struct test_easing *easing, double min_error, double max_error)
+{
+    struct easing_lut lut;
+    if (max_error < min_error) {
+        ngli_assert(ngli_easing_lut_init(&lut, eval_easing, easing, max_error) == NGL_ERROR_LIMIT_EXCEEDED);
+        ngli_assert(!lut.values);
+        return;
+    }
+    ngli_assert(ngli_easing_lut_init(&lut, eval_easing, easing, max_error) == 0);
+
+    /*
+     * The evaluation points are unrelated to the ones used to size the
+     * table, and include both ends of the range.
+     */
+    double err = 0.0;
+    for (int i = 0; i <= NB_EVALS; i++) {
+        const double t = i / (double)NB_EVALS;
+        err = NGLI_MAX(err, fabs(ngli_easing_lut_evaluate(&lut, t) - eval_easing(easing, t)));
+    }
+    for (int i = 0; i < NB_EVALS / 16; i++) {
+        const double t = rand() / (double)RAND_MAX;
+        err = NGLI_MAX(err, fabs(ngli_easing_lut_evaluate(&lut, t) - eval_easing(easing, t)));
+    }
+
+    printf("%-10s max_error=%-6g intervals=%-5d measured error=%g\n",
+           easing->name, max_error, lut.nb_intervals, err);
+    if (err > max_error) {
+        fprintf(stderr, "%s: error %g exceeds %g\n", easing->name, err, max_error);
+        abort();
+    }
+    ngli_easing_lut_reset(&lut);
+}
+
+static void bench(const struct test_easing *easing, double max_error)
+{
+    struct easing_lut lut;
+    ngli_assert(ngli_easing_lut_init(&lut, eval_easing, easing, max_error) == 0);
+
+    double *times = ngli_calloc(NB_EVALS, sizeof(*times));
+    double *values = ngli_calloc(NB_EVALS, sizeof(*values));
+    ngli_assert(times && values);
+    for (int i = 0; i < NB_EVALS; i++)
+        times[i] = i / (double)NB_EVALS;
+
+    double sum = 0.0, ref_sum = 0.0;
+    const int64_t t0 = ngli_gettime_relative();
+    for (int i = 0; i < NB_EVALS; i++)
+        sum += ngli_easing_lut_evaluate(&lut, times[i]);
+    const int64_t t1 = ngli_gettime_relative();
+    const easing_function func = ngli_easing_get(easing->id)->function;
+    for (int i = 0; i < NB_EVALS; i++)
+        values[i] = func(times[i], easing->nb_args, easing->args);
+    const int64_t t2 = ngli_gettime_relative();
+    for (int i = 0; i < NB_EVALS; i++)
+        ref_sum += values[i];
+
+    printf("%-10s table: %.1f ns/eval (exact: %.1f ns/eval)\n", easing->name,
+           (t1 - t0) * 1000. / NB_EVALS, (t2 - t1) * 1000. / NB_EVALS);
+    ngli_assert(fabs(sum - ref_sum) <= max_error * NB_EVALS);
+    ngli_free(values);
+    ngli_free(times);
+    ngli_easing_lut_reset(&lut);
+}
+
+int main(void)
+{
+    for (int i = 0; i < NGLI_ARRAY_NB(easings); i++)
+        for (int j = 0; j < NGLI_ARRAY_NB(max_errors); j++)
+            check_error(&easings[i].easing, easings[i].min_error, max_errors[j]);
+
+    check_error(&circular_in, 1.0, 1e-4);
+
+    struct easing_lut lut;
+    ngli_assert(ngli_easing_lut_init(&lut, eval_easing, &easings[0].easing, 0.0) == NGL_ERROR_INVALID_ARG);
+
+    for (int i = 0; i < NGLI_ARRAY_NB(easings); i++)
+        bench(&easings[i].easing, 1e-3);
+
+    return 0;
+}
@@ -21,8 +21,10 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <math.h>
 
+#include "memory.h"
 #include "noise.h"
 #include "utils.h"
 
@@ -112,6 +114,130 @@ static int run_test(void)
     return ret;
 }
 
+/* The arch and C 4-lane kernels are checked against the scalar path */
+#define LANES_MAX_ERR 1e-5
+#define NB_LANES_TESTS 4096
+
+typedef void (*fbm4_func_type)(float *dst, const float *t, const uint32_t *seeds, const struct noise_fbm4_params *p);
+
+static int check_fbm4(const char *name, fbm4_func_type fbm4, const struct noise_params *np)
+{
+    struct noise noise;
+    if (ngli_noise_init(&noise, np) < 0)
+        return EXIT_FAILURE;
+
+    uint32_t state = np->seed;
+    for (int i = 0; i < NB_LANES_TESTS; i++) {
+        float t[4];
+        uint32_t seeds[4];
+        for (int k = 0; k < 4; k++) {
+            state = state * 1664525 + 1013904223;
+            t[k] = ((int32_t)state >> 8) / (float)(1 << 19); // [-16;16)
+            seeds[k] = np->seed + k * (UINT32_MAX / 4);
+        }
+
+        float out[4];
+        fbm4(out, t, seeds, &noise.fbm4_params);
+
+        for (int k = 0; k < 4; k++) {
+            struct noise ref;
+            struct noise_params ref_params = *np;
+            ref_params.seed = seeds[k];
+            if (ngli_noise_init(&ref, &ref_params) < 0)
+                return EXIT_FAILURE;
+            const float ev = ngli_noise_get(&ref, t[k]);
+            const float err = fabsf(out[k] - ev);
+            if (err > LANES_MAX_ERR * np->amplitude) {
+                fprintf(stderr, "%s: noise(%f) lane %d = %g but expected %g [err:%g]\n",
+                        name, t[k], k, out[k], ev, err);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return 0;
+}
+
+static int run_lanes_test(void)
+{
+    for (int k = 0; k < NGLI_ARRAY_NB(noise_tests); k++) {
+        const struct noise_test *test = &noise_tests[k];
+        if (check_fbm4("C", ngli_noise_fbm4_c, &test->p) ||
+            check_fbm4("arch", ngli_noise_fbm4, &test->p))
+            return EXIT_FAILURE;
+
+        /* Batched evaluation, including a partial last batch */
+        struct noise noise;
+        if (ngli_noise_init(&noise, &test->p) < 0)
+            return EXIT_FAILURE;
+        const int nb_values = NGLI_ARRAY_NB(test->expected_values);
+        float t[NGLI_ARRAY_NB(test->expected_values)];
+        float values[NGLI_ARRAY_NB(test->expected_values)];
+        for (int i = 0; i < nb_values; i++)
+            t[i] = i / 10.f;
+        ngli_noise_get_n(&noise, values, t, nb_values);
+        for (int i = 0; i < nb_values; i++) {
+            const float ev = test->expected_values[i];
+            if (fabs(values[i] - ev) > 0.0001) {
+                fprintf(stderr, "noise_n(%f)=%g but expected %g\n", t[i], values[i], ev);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    return 0;
+}
+
+#define NB_BENCH_VALUES (1 << 16)
+
+static void run_bench(const struct noise_params *np)
+{
+    struct noise noise;
+    ngli_assert(ngli_noise_init(&noise, np) >= 0);
+
+    float *t = ngli_calloc(NB_BENCH_VALUES, sizeof(*t));
+    float *dst = ngli_calloc(NB_BENCH_VALUES, sizeof(*dst));
+    ngli_assert(t && dst);
+    for (int i = 0; i < NB_BENCH_VALUES; i++)
+        t[i] = i / 60.f;
+
+    const int64_t t0 = ngli_gettime_relative();
+    for (int i = 0; i < NB_BENCH_VALUES; i++)
+        dst[i] = ngli_noise_get(&noise, t[i]);
+    const int64_t t1 = ngli_gettime_relative();
+    ngli_noise_get_n(&noise, dst, t, NB_BENCH_VALUES);
+    const int64_t t2 = ngli_gettime_relative();
+
+    printf("%d samples, %d octaves: scalar %.1f ns/sample, batched %.1f ns/sample\n",
+           NB_BENCH_VALUES, np->octaves,
+           (t1 - t0) * 1000. / NB_BENCH_VALUES,
+           (t2 - t1) * 1000. / NB_BENCH_VALUES);
+
+    /* vec4 noise: 4 scalar generators against the 4 lanes of the kernel */
+    struct noise generators[4];
+    uint32_t seeds[4];
+    for (int k = 0; k < 4; k++) {
+        struct noise_params gen_params = *np;
+        gen_params.seed = seeds[k] = np->seed + k * (UINT32_MAX / 4);
+        ngli_assert(ngli_noise_init(&generators[k], &gen_params) >= 0);
+    }
+    const int nb_vec4 = NB_BENCH_VALUES / 4;
+    const int64_t t3 = ngli_gettime_relative();
+    for (int i = 0; i < nb_vec4; i++)
+        for (int k = 0; k < 4; k++)
+            dst[i * 4 + k] = ngli_noise_get(&generators[k], t[i]);
+    const int64_t t4 = ngli_gettime_relative();
+    for (int i = 0; i < nb_vec4; i++)
+        ngli_noise_get_vec(&noise, dst + i * 4, t[i], seeds, 4);
+    const int64_t t5 = ngli_gettime_relative();
+
+    printf("%d vec4, %d octaves: scalar %.1f ns/vec4, lanes %.1f ns/vec4\n",
+           nb_vec4, np->octaves,
+           (t4 - t3) * 1000. / nb_vec4,
+           (t5 - t4) * 1000. / nb_vec4);
+
+    ngli_free(t);
+    ngli_free(dst);
+}
+
 static const struct noise_params default_params = {
     .amplitude  = 1.0,
     .octaves    = 8,
@@ -123,8 +249,14 @@ static const struct noise_params default_params = {
 
 int main(int ac, char **av)
 {
-    if (ac == 1)
-        return run_test();
+    if (ac == 1) {
+        int ret = run_test();
+        if (ret == 0)
+            ret = run_lanes_test();
+        if (ret == 0)
+            run_bench(&default_params);
+        return ret;
+    }
 
     const float duration = ac > 1 ? atof(av[1]) : 3.f;
     const float frequency = ac > 2 ? atof(av[2]) : 10.f;
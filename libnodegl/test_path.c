@@ -20,9 +20,12 @@
  */
 
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include "math_utils.h"
 #include "path.h"
 #include "utils.h"
 
@@ -112,7 +115,7 @@ static int test_bezier3_vec3(void)
         (ret = ngli_path_bezier3_to(path, controls[0], controls[1], points[1])) < 0)
         goto end;
 
-    ret = ngli_path_init(path, 3);
+    ret = ngli_path_init(path, 3, 0.f);
     if (ret < 0)
         goto end;
 
@@ -177,7 +180,7 @@ static int test_poly_bezier3(void)
         (ret = ngli_path_bezier3_to(path, controls[6], controls[7], points[4])) < 0)
         goto end;
 
-    ret = ngli_path_init(path, 64);
+    ret = ngli_path_init(path, 64, 0.f);
     if (ret < 0)
         goto end;
 
@@ -253,7 +256,7 @@ static int test_composition(void)
         (ret = ngli_path_bezier2_to(path, controls[6], points[10])) < 0)
         goto end;
 
-    ret = ngli_path_init(path, 64);
+    ret = ngli_path_init(path, 64, 0.f);
     if (ret < 0)
         goto end;
 
@@ -264,13 +267,179 @@ end:
     return ret;
 }
 
+#define NB_BENCH_SEGMENTS 256
+#define NB_BENCH_VALUES   4096
+#define NB_BENCH_RUNS     50
+
+static int cmp_float(const void *a, const void *b)
+{
+    const float fa = *(const float *)a;
+    const float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static struct path *create_bench_path(int precision, float tolerance, int with_moves)
+{
+    struct path *path = ngli_path_create();
+    if (!path)
+        return NULL;
+
+    int ret = ngli_path_move_to(path, (const float[3]){0.f, 0.f, 0.f});
+    for (int i = 0; i < NB_BENCH_SEGMENTS && ret >= 0; i++) {
+        /* Alternate tight and nearly flat curves */
+        const float x = (float)i;
+        const float amp = (i & 2) ? 1.f : .02f;
+        const float ctl0[3] = {x + .3f, (i & 1) ? amp : -amp, 0.f};
+        const float ctl1[3] = {x + .6f, (i & 1) ? -amp : amp, .2f * amp};
+        const float to[3]   = {x + 1.f, 0.f, 0.f};
+        if (with_moves && i % 64 == 63)
+            ret = ngli_path_move_to(path, to);
+        else if (i % 8 == 7)
+            ret = ngli_path_line_to(path, to);
+        else
+            ret = ngli_path_bezier3_to(path, ctl0, ctl1, to);
+    }
+    if (ret >= 0)
+        ret = ngli_path_init(path, precision, tolerance);
+    if (ret < 0)
+        ngli_path_freep(&path);
+    return path;
+}
+
+static int test_batch(void)
+{
+    printf("test: batched evaluation\n");
+
+    int ret = 0;
+    struct path *path = create_bench_path(64, 0.f, 1);
+    if (!path)
+        return -1;
+
+    float *distances = malloc(NB_BENCH_VALUES * sizeof(*distances));
+    float *values = malloc(NB_BENCH_VALUES * 3 * sizeof(*values));
+    float *refs = malloc(NB_BENCH_VALUES * 3 * sizeof(*refs));
+    if (!distances || !values || !refs) {
+        ret = -1;
+        goto end_bench;
+    }
+
+    srand(0);
+    for (int i = 0; i < NB_BENCH_VALUES; i++)
+        distances[i] = rand() / (float)RAND_MAX * 1.2f - .1f;
+
+    /* Unsorted distances */
+    int64_t t0 = ngli_gettime_relative();
+    for (int r = 0; r < NB_BENCH_RUNS; r++)
+        for (int i = 0; i < NB_BENCH_VALUES; i++)
+            ngli_path_evaluate(path, &refs[i * 3], distances[i]);
+    int64_t t1 = ngli_gettime_relative();
+    ngli_path_evaluate_n(path, values, distances, NB_BENCH_VALUES);
+    if (memcmp(values, refs, NB_BENCH_VALUES * 3 * sizeof(*values))) {
+        fprintf(stderr, "batched evaluation of unsorted distances differs\n");
+        ret = -1;
+        goto end_bench;
+    }
+    printf("random access: %.1f ns/value\n",
+           (t1 - t0) * 1000. / (NB_BENCH_RUNS * NB_BENCH_VALUES));
+
+    /* Sorted distances */
+    qsort(distances, NB_BENCH_VALUES, sizeof(*distances), cmp_float);
+    for (int i = 0; i < NB_BENCH_VALUES; i++)
+        ngli_path_evaluate(path, &refs[i * 3], distances[i]);
+    t0 = ngli_gettime_relative();
+    for (int r = 0; r < NB_BENCH_RUNS; r++)
+        ngli_path_evaluate_n(path, values, distances, NB_BENCH_VALUES);
+    t1 = ngli_gettime_relative();
+    if (memcmp(values, refs, NB_BENCH_VALUES * 3 * sizeof(*values))) {
+        fprintf(stderr, "batched evaluation of sorted distances differs\n");
+        ret = -1;
+        goto end_bench;
+    }
+    printf("batched sweep: %.1f ns/value\n",
+           (t1 - t0) * 1000. / (NB_BENCH_RUNS * NB_BENCH_VALUES));
+
+end_bench:
+    free(refs);
+    free(values);
+    free(distances);
+    ngli_path_freep(&path);
+    return ret;
+}
+
+#define NB_ADAPTIVE_VALUES 2000
+#define ADAPTIVE_TOLERANCE 1e-3f
+#define MAX_ADAPTIVE_ERR   (2 * ADAPTIVE_TOLERANCE)
+
+static float get_max_error(const struct path *path, const float *refs)
+{
+    float max_err = 0.f;
+    for (int i = 0; i < NB_ADAPTIVE_VALUES; i++) {
+        const float t = i / (NB_ADAPTIVE_VALUES - 1.f);
+        float value[3];
+        ngli_path_evaluate(path, value, t);
+        const float *ref = &refs[i * 3];
+        const float err[3] = NGLI_VEC3_SUB(value, ref);
+        max_err = NGLI_MAX(max_err, ngli_vec3_length(err));
+    }
+    return max_err;
+}
+
+static int test_adaptive(void)
+{
+    printf("test: adaptive subdivision\n");
+
+    /* Reference with a high fixed precision */
+    struct path *path = create_bench_path(1024, 0.f, 0);
+    if (!path)
+        return -1;
+    float *refs = malloc(NB_ADAPTIVE_VALUES * 3 * sizeof(*refs));
+    if (!refs) {
+        ngli_path_freep(&path);
+        return -1;
+    }
+    for (int i = 0; i < NB_ADAPTIVE_VALUES; i++)
+        ngli_path_evaluate(path, &refs[i * 3], i / (NB_ADAPTIVE_VALUES - 1.f));
+    ngli_path_freep(&path);
+
+    int ret = 0;
+    static const struct {
+        int precision;
+        float tolerance;
+    } configs[] = {
+        {64,   0.f},
+        {1024, ADAPTIVE_TOLERANCE},
+    };
+    for (int i = 0; i < NGLI_ARRAY_NB(configs); i++) {
+        const int64_t t0 = ngli_gettime_relative();
+        path = create_bench_path(configs[i].precision, configs[i].tolerance, 0);
+        const int64_t t1 = ngli_gettime_relative();
+        if (!path) {
+            ret = -1;
+            break;
+        }
+        const float max_err = get_max_error(path, refs);
+        printf("precision:%d tolerance:%g init:%dus max_err:%g\n",
+               configs[i].precision, configs[i].tolerance, (int)(t1 - t0), max_err);
+        ngli_path_freep(&path);
+        if (configs[i].tolerance && max_err > MAX_ADAPTIVE_ERR) {
+            fprintf(stderr, "adaptive subdivision error too large: %g > %g\n", max_err, MAX_ADAPTIVE_ERR);
+            ret = -1;
+        }
+    }
+
+    free(refs);
+    return ret;
+}
+
 int main(int ac, char **av)
 {
     int ret;
 
     if ((ret = test_bezier3_vec3()) < 0 ||
         (ret = test_poly_bezier3()) < 0 ||
-        (ret = test_composition()) < 0)
+        (ret = test_composition()) < 0 ||
+        (ret = test_batch()) < 0 ||
+        (ret = test_adaptive()) < 0)
         return 1;
     return 0;
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "path.h"
+#include "utils.h"
+
+/*
+ * Colliding hashes are forced by overriding the path hash function used by
+ * the cache, so that only the segments comparison can tell the paths apart.
+ */
+static int force_collision;
+
+static uint64_t get_path_hash(const struct path *s, int precision, float tolerance)
+{
+    return force_collision ? 0 : ngli_path_get_hash(s, precision, tolerance);
+}
+
+#define ngli_path_get_hash get_path_hash
+#include "pathcache.c"
+#undef ngli_path_get_hash
+
+#define PRECISION 8
+#define TOLERANCE 0.001f
+
+static struct path *create_path(float x)
+{
+    struct path *path = ngli_path_create();
+    ngli_assert(path);
+    const float points[2][3] = {{x, 0.f, 0.f}, {1.f, 1.f, 0.f}};
+    const float controls[2][3] = {{x, 1.f, 0.f}, {1.f, 0.f, 0.f}};
+    ngli_assert(ngli_path_move_to(path, points[0]) >= 0);
+    ngli_assert(ngli_path_bezier3_to(path, controls[0], controls[1], points[1]) >= 0);
+    return path;
+}
+
+static void test_sharing(struct pathcache *cache)
+{
+    printf("test: sharing (collision:%s)\n", force_collision ? "yes" : "no");
+
+    struct path *p0 = create_path(0.f);
+    struct path *p1 = create_path(0.f);
+    struct path *p2 = create_path(0.5f);
+
+    ngli_assert(ngli_pathcache_init_path(cache, &p0, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(ngli_pathcache_init_path(cache, &p1, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(ngli_pathcache_init_path(cache, &p2, PRECISION, TOLERANCE) >= 0);
+
+    /* Identical curves share their path, the other one gets its own */
+    ngli_assert(p0 == p1);
+    ngli_assert(p2 != p0);
+    ngli_assert(ngli_hmap_count(cache->paths) == (force_collision ? 1 : 2));
+
+    /* Same curve with different parameters */
+    struct path *p3 = create_path(0.f);
+    ngli_assert(ngli_pathcache_init_path(cache, &p3, PRECISION * 2, TOLERANCE) >= 0);
+    ngli_assert(p3 != p0);
+
+    /* The paths are released to zero in a different order than acquired */
+    ngli_pathcache_release_path(cache, &p2, PRECISION, TOLERANCE);
+    ngli_pathcache_release_path(cache, &p0, PRECISION, TOLERANCE);
+    ngli_assert(!p0 && !p2);
+    ngli_assert(ngli_hmap_count(cache->paths) == (force_collision ? 1 : 2));
+
+    ngli_pathcache_release_path(cache, &p3, PRECISION * 2, TOLERANCE);
+    ngli_assert(ngli_hmap_count(cache->paths) == 1);
+
+    ngli_pathcache_release_path(cache, &p1, PRECISION, TOLERANCE);
+    ngli_assert(!p1);
+    ngli_assert(ngli_hmap_count(cache->paths) == 0);
+
+    /* Releasing twice is a no-op */
+    ngli_pathcache_release_path(cache, &p1, PRECISION, TOLERANCE);
+}
+
+static void test_collision_owner(struct pathcache *cache)
+{
+    printf("test: collision with the cached path released first\n");
+
+    force_collision = 1;
+
+    struct path *p0 = create_path(0.f);
+    struct path *p1 = create_path(0.5f);
+    ngli_assert(ngli_pathcache_init_path(cache, &p0, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(ngli_pathcache_init_path(cache, &p1, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(p0 != p1);
+
+    /* The cached path goes away while the colliding one is still alive */
+    ngli_pathcache_release_path(cache, &p0, PRECISION, TOLERANCE);
+    ngli_assert(ngli_hmap_count(cache->paths) == 0);
+
+    /* The uncached path must not be confused with a new cache entry */
+    struct path *p2 = create_path(0.f);
+    ngli_assert(ngli_pathcache_init_path(cache, &p2, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(ngli_hmap_count(cache->paths) == 1);
+    ngli_pathcache_release_path(cache, &p1, PRECISION, TOLERANCE);
+    ngli_assert(ngli_hmap_count(cache->paths) == 1);
+    ngli_pathcache_release_path(cache, &p2, PRECISION, TOLERANCE);
+    ngli_assert(ngli_hmap_count(cache->paths) == 0);
+
+    force_collision = 0;
+}
+
+static void test_reset(struct pathcache *cache)
+{
+    printf("test: reset\n");
+
+    /* Paths left in the cache are freed by the reset */
+    struct path *p0 = create_path(0.f);
+    ngli_assert(ngli_pathcache_init_path(cache, &p0, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(ngli_hmap_count(cache->paths) == 1);
+
+    ngli_pathcache_reset(cache);
+    ngli_assert(!cache->paths);
+    ngli_pathcache_reset(cache);
+
+    /* Same sequence as a context stop followed by a reconfigure */
+    ngli_assert(ngli_pathcache_init(cache) >= 0);
+    ngli_assert(ngli_hmap_count(cache->paths) == 0);
+
+    struct path *p1 = create_path(0.f);
+    ngli_assert(ngli_pathcache_init_path(cache, &p1, PRECISION, TOLERANCE) >= 0);
+    ngli_assert(ngli_hmap_count(cache->paths) == 1);
+    ngli_pathcache_release_path(cache, &p1, PRECISION, TOLERANCE);
+    ngli_assert(ngli_hmap_count(cache->paths) == 0);
+}
+
+int main(void)
+{
+    struct pathcache cache = {0};
+    ngli_assert(ngli_pathcache_init(&cache) >= 0);
+
+    for (force_collision = 0; force_collision <= 1; force_collision++)
+        test_sharing(&cache);
+    force_collision = 0;
+
+    test_collision_owner(&cache);
+    test_reset(&cache);
+
+    ngli_pathcache_reset(&cache);
+    return 0;
+}
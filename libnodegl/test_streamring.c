@@ -0,0 +1,188 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "atomic_compat.h"
+#include "nodegl.h"
+#include "pthread_compat.h"
+#include "streamring.h"
+#include "utils.h"
+
+#define NB_PUSHES 2000000
+#define CAPACITY 64
+
+/* Every field is derived from the sample index so that torn reads are detected */
+struct sample {
+    int64_t index;
+    int64_t values[7];
+};
+
+static void make_sample(struct sample *sample, int64_t index)
+{
+    sample->index = index;
+    for (int i = 0; i < NGLI_ARRAY_NB(sample->values); i++)
+        sample->values[i] = index * (i + 3) ^ i;
+}
+
+static int check_sample(const struct sample *sample)
+{
+    struct sample ref;
+    make_sample(&ref, sample->index);
+    for (int i = 0; i < NGLI_ARRAY_NB(ref.values); i++)
+        if (sample->values[i] != ref.values[i])
+            return 0;
+    return 1;
+}
+
+static int64_t read_index(struct streamring *ring, int64_t t)
+{
+    struct sample sample;
+    const int ret = ngli_streamring_read(ring, t, &sample);
+    ngli_assert(ret == 1);
+    ngli_assert(check_sample(&sample));
+    return sample.index;
+}
+
+static void test_lookup(void)
+{
+    struct streamring *ring = ngli_streamring_create(8, sizeof(struct sample), 0);
+    ngli_assert(ring);
+
+    struct sample sample;
+    ngli_assert(ngli_streamring_read(ring, 0, &sample) == 0);
+
+    /* Timestamps 10, 20, 20, 30, ..., with a duplicate */
+    int64_t ts = 0;
+    for (int i = 0; i < 6; i++) {
+        if (i != 2)
+            ts += 10;
+        make_sample(&sample, i);
+        ngli_assert(ngli_streamring_push(ring, ts, &sample, sizeof(sample)) == 0);
+    }
+    ngli_assert(ngli_streamring_push(ring, ts - 1, &sample, sizeof(sample)) == NGL_ERROR_INVALID_ARG);
+    ngli_assert(ngli_streamring_push(ring, ts, &sample, sizeof(sample) - 1) == NGL_ERROR_INVALID_ARG);
+
+    ngli_assert(read_index(ring, 0) == 0);
+    ngli_assert(read_index(ring, 10) == 0);
+    ngli_assert(read_index(ring, 19) == 0);
+    ngli_assert(read_index(ring, 20) == 2);
+    ngli_assert(read_index(ring, 35) == 3);
+    ngli_assert(read_index(ring, 1000) == 5);
+
+    /* Evict the oldest samples: only the 8 last ones (10 to 17) remain */
+    for (int i = 6; i < 18; i++) {
+        ts += 10;
+        make_sample(&sample, i);
+        ngli_assert(ngli_streamring_push(ring, ts, &sample, sizeof(sample)) == 0);
+    }
+    ngli_assert(read_index(ring, 0) == 10);
+    ngli_assert(read_index(ring, ts - 15) == 15);
+    ngli_assert(read_index(ring, ts) == 17);
+
+    ngli_streamring_freep(&ring);
+    ngli_assert(!ring);
+}
+
+static void test_window(void)
+{
+    struct streamring *ring = ngli_streamring_create(100, sizeof(struct sample), 25);
+    ngli_assert(ring);
+
+    struct sample sample;
+    for (int i = 0; i < 10; i++) {
+        make_sample(&sample, i);
+        ngli_assert(ngli_streamring_push(ring, i * 10, &sample, sizeof(sample)) == 0);
+    }
+
+    /* The last timestamp is 90: everything before 65 is out of the window */
+    ngli_assert(read_index(ring, 0) == 7);
+    ngli_assert(read_index(ring, 75) == 7);
+    ngli_assert(read_index(ring, 80) == 8);
+    ngli_assert(read_index(ring, 95) == 9);
+
+    ngli_streamring_freep(&ring);
+}
+
+struct stress {
+    struct streamring *ring;
+    int done; /* accessed atomically */
+};
+
+static void *producer_thread(void *arg)
+{
+    struct stress *s = arg;
+    for (int i = 0; i < NB_PUSHES; i++) {
+        struct sample sample;
+        make_sample(&sample, i);
+        ngli_assert(ngli_streamring_push(s->ring, i, &sample, sizeof(sample)) == 0);
+    }
+    ngli_atomic_store(&s->done, 1);
+    return NULL;
+}
+
+static void test_concurrency(void)
+{
+    struct stress s = {.ring = ngli_streamring_create(CAPACITY, sizeof(struct sample), 0)};
+    ngli_assert(s.ring);
+
+    pthread_t tid;
+    ngli_assert(pthread_create(&tid, NULL, producer_thread, &s) == 0);
+
+    int nb_reads = 0, nb_failures = 0;
+    int64_t last_index = 0;
+    while (!ngli_atomic_load(&s.done)) {
+        /* Alternate between the most recent samples and the oldest ones */
+        const int64_t t = nb_reads & 1 ? INT64_MAX : 0;
+        struct sample sample;
+        const int ret = ngli_streamring_read(s.ring, t, &sample);
+        nb_reads++;
+        if (ret == NGL_ERROR_LIMIT_EXCEEDED) {
+            nb_failures++;
+            continue;
+        }
+        ngli_assert(ret >= 0);
+        if (!ret)
+            continue;
+        ngli_assert(check_sample(&sample));
+        if (t == INT64_MAX) {
+            ngli_assert(sample.index >= last_index);
+            last_index = sample.index;
+        }
+    }
+    pthread_join(tid, NULL);
+
+    ngli_assert(read_index(s.ring, INT64_MAX) == NB_PUSHES - 1);
+    ngli_assert(read_index(s.ring, 0) == NB_PUSHES - CAPACITY);
+    printf("%d concurrent reads, %d given up\n", nb_reads, nb_failures);
+
+    ngli_streamring_freep(&s.ring);
+}
+
+int main(void)
+{
+    test_lookup();
+    test_window();
+    test_concurrency();
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "threadpool.h"
+#include "utils.h"
+
+#define NB_JOBS 1000
+
+struct job_ctx {
+    int results[NB_JOBS];
+    int fail_job;
+};
+
+static int job_func(void *arg, int job_id)
+{
+    struct job_ctx *s = arg;
+    if (job_id == s->fail_job)
+        return -1;
+    s->results[job_id] = job_id * job_id;
+    return 0;
+}
+
+int main(void)
+{
+    for (int nb_threads = 1; nb_threads <= 8; nb_threads++) {
+        struct threadpool *pool = ngli_threadpool_create(nb_threads);
+        ngli_assert(pool);
+        ngli_assert(ngli_threadpool_get_nb_threads(pool) == nb_threads);
+
+        for (int nb_jobs = 0; nb_jobs <= NB_JOBS; nb_jobs = nb_jobs ? nb_jobs * 10 : 1) {
+            struct job_ctx s = {.fail_job = -1};
+            int ret = ngli_threadpool_run(pool, job_func, &s, nb_jobs);
+            ngli_assert(ret == 0);
+            for (int i = 0; i < nb_jobs; i++)
+                ngli_assert(s.results[i] == i * i);
+            for (int i = nb_jobs; i < NB_JOBS; i++)
+                ngli_assert(s.results[i] == 0);
+        }
+
+        struct job_ctx s = {.fail_job = NB_JOBS / 3};
+        int ret = ngli_threadpool_run(pool, job_func, &s, NB_JOBS);
+        ngli_assert(ret == -1);
+        for (int i = 0; i < NB_JOBS; i++)
+            ngli_assert(i == s.fail_job || s.results[i] == i * i);
+
+        printf("%d thread(s): OK\n", nb_threads);
+        ngli_threadpool_freep(&pool);
+        ngli_assert(!pool);
+    }
+
+    return 0;
+}
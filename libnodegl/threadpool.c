@@ -0,0 +1,225 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+
+#include "memory.h"
+#include "pthread_compat.h"
+#include "threadpool.h"
+#include "utils.h"
+
+struct worker {
+    struct threadpool *pool;
+    pthread_t tid;
+    int thread_started;
+
+    /* Queue of pending jobs, shared with the thieves */
+    pthread_mutex_t lock;
+    int job_start;
+    int job_end;
+};
+
+struct threadpool {
+    struct worker *workers;
+    int nb_workers;
+
+    pthread_mutex_t lock;
+    pthread_cond_t cond_wkr;
+    pthread_cond_t cond_ctl;
+    int run_id;
+    int nb_running;
+    int stop;
+    threadpool_job_func func;
+    void *arg;
+    int ret;
+};
+
+static int pop_job(struct worker *w)
+{
+    int job_id = -1;
+    pthread_mutex_lock(&w->lock);
+    if (w->job_start < w->job_end)
+        job_id = w->job_start++;
+    pthread_mutex_unlock(&w->lock);
+    return job_id;
+}
+
+static int steal_job(struct worker *w)
+{
+    int job_id = -1;
+    pthread_mutex_lock(&w->lock);
+    if (w->job_start < w->job_end)
+        job_id = --w->job_end;
+    pthread_mutex_unlock(&w->lock);
+    return job_id;
+}
+
+static void execute_jobs(struct threadpool *s, int worker_id)
+{
+    for (;;) {
+        int job_id = pop_job(&s->workers[worker_id]);
+        for (int i = 1; job_id < 0 && i < s->nb_workers; i++)
+            job_id = steal_job(&s->workers[(worker_id + i) % s->nb_workers]);
+        if (job_id < 0)
+            break;
+
+        int ret = s->func(s->arg, job_id);
+        if (ret < 0) {
+            pthread_mutex_lock(&s->lock);
+            if (!s->ret)
+                s->ret = ret;
+            pthread_mutex_unlock(&s->lock);
+        }
+    }
+}
+
+static void *worker_thread(void *arg)
+{
+    struct worker *w = arg;
+    struct threadpool *s = w->pool;
+    const int worker_id = w - s->workers;
+
+    ngli_thread_set_name("ngl-pool");
+
+    int run_id = 0;
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->stop && s->run_id == run_id)
+            pthread_cond_wait(&s->cond_wkr, &s->lock);
+        if (s->stop)
+            break;
+        run_id = s->run_id;
+        pthread_mutex_unlock(&s->lock);
+
+        execute_jobs(s, worker_id);
+
+        pthread_mutex_lock(&s->lock);
+        if (--s->nb_running == 0)
+            pthread_cond_signal(&s->cond_ctl);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return NULL;
+}
+
+struct threadpool *ngli_threadpool_create(int nb_threads)
+{
+    if (nb_threads < 1)
+        return NULL;
+
+    struct threadpool *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->workers = ngli_calloc(nb_threads, sizeof(*s->workers));
+    if (!s->workers) {
+        ngli_free(s);
+        return NULL;
+    }
+
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->cond_wkr, NULL);
+    pthread_cond_init(&s->cond_ctl, NULL);
+
+    for (int i = 0; i < nb_threads; i++) {
+        struct worker *w = &s->workers[i];
+        w->pool = s;
+        pthread_mutex_init(&w->lock, NULL);
+        s->nb_workers++;
+    }
+
+    /* Worker 0 is the thread calling ngli_threadpool_run() */
+    for (int i = 1; i < nb_threads; i++) {
+        struct worker *w = &s->workers[i];
+        if (pthread_create(&w->tid, NULL, worker_thread, w)) {
+            ngli_threadpool_freep(&s);
+            return NULL;
+        }
+        w->thread_started = 1;
+    }
+
+    return s;
+}
+
+int ngli_threadpool_run(struct threadpool *s, threadpool_job_func func, void *arg, int nb_jobs)
+{
+    if (nb_jobs <= 0)
+        return 0;
+
+    for (int i = 0; i < s->nb_workers; i++) {
+        struct worker *w = &s->workers[i];
+        pthread_mutex_lock(&w->lock);
+        w->job_start = (int)((int64_t)nb_jobs *  i      / s->nb_workers);
+        w->job_end   = (int)((int64_t)nb_jobs * (i + 1) / s->nb_workers);
+        pthread_mutex_unlock(&w->lock);
+    }
+
+    pthread_mutex_lock(&s->lock);
+    s->func = func;
+    s->arg = arg;
+    s->ret = 0;
+    s->nb_running = s->nb_workers - 1;
+    s->run_id++;
+    pthread_cond_broadcast(&s->cond_wkr);
+    pthread_mutex_unlock(&s->lock);
+
+    execute_jobs(s, 0);
+
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_running)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    const int ret = s->ret;
+    s->func = NULL;
+    s->arg = NULL;
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
+int ngli_threadpool_get_nb_threads(const struct threadpool *s)
+{
+    return s->nb_workers;
+}
+
+void ngli_threadpool_freep(struct threadpool **sp)
+{
+    struct threadpool *s = *sp;
+    if (!s)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    s->stop = 1;
+    pthread_cond_broadcast(&s->cond_wkr);
+    pthread_mutex_unlock(&s->lock);
+
+    for (int i = 0; i < s->nb_workers; i++) {
+        struct worker *w = &s->workers[i];
+        if (w->thread_started)
+            pthread_join(w->tid, NULL);
+        pthread_mutex_destroy(&w->lock);
+    }
+
+    pthread_cond_destroy(&s->cond_ctl);
+    pthread_cond_destroy(&s->cond_wkr);
+    pthread_mutex_destroy(&s->lock);
+    ngli_free(s->workers);
+    ngli_freep(sp);
+}
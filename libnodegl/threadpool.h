@@ -0,0 +1,48 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+struct threadpool;
+
+typedef int (*threadpool_job_func)(void *arg, int job_id);
+
+/*
+ * Create a pool of nb_threads workers, including the calling thread: only
+ * nb_threads-1 helper threads are actually spawned.
+ */
+struct threadpool *ngli_threadpool_create(int nb_threads);
+
+/*
+ * Execute the jobs [0,nb_jobs) and wait for their completion. The jobs are
+ * initially split evenly between the workers; a worker running out of jobs
+ * steals from the tail of the other workers queues.
+ *
+ * Returns the first error encountered by a job, or 0 on success.
+ */
+int ngli_threadpool_run(struct threadpool *s, threadpool_job_func func, void *arg, int nb_jobs);
+
+int ngli_threadpool_get_nb_threads(const struct threadpool *s);
+
+void ngli_threadpool_freep(struct threadpool **sp);
+
+#endif
@@ -20,11 +20,26 @@
  */
 
 #include <string.h>
+#include "drawlist.h"
 #include "log.h"
 #include "nodegl.h"
 #include "math_utils.h"
+#include "memory.h"
 #include "transforms.h"
 
+/*
+ * A static transform (one without animation) caches the product of its
+ * matrix with the matrices of the consecutive static transforms below it,
+ * child being the first node after them. The chain is allocated at prepare
+ * time, after all the nodes, to keep the nodes walked at every frame close
+ * to each other in memory.
+ */
+struct transform_chain {
+    float matrix[4*4];
+    struct ngl_node *child;
+    int dirty;
+};
+
 const float *ngli_get_last_transformation_matrix(const struct ngl_node *node)
 {
     while (node) {
@@ -54,11 +69,110 @@ const float *ngli_get_last_transformation_matrix(const struct ngl_node *node)
     return NULL;
 }
 
+static int is_transform(const struct ngl_node *node)
+{
+    switch (node->cls->id) {
+    case NGL_NODE_ROTATE:
+    case NGL_NODE_ROTATEQUAT:
+    case NGL_NODE_SCALE:
+    case NGL_NODE_SKEW:
+    case NGL_NODE_TRANSFORM:
+    case NGL_NODE_TRANSLATE:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+int ngli_transform_prepare(struct ngl_node *node)
+{
+    struct transform_priv *s = node->priv_data;
+
+    struct darray *children_array = &node->children;
+    struct ngl_node **children = ngli_darray_data(children_array);
+    for (int i = 0; i < ngli_darray_count(children_array); i++) {
+        int ret = ngli_node_prepare(children[i]);
+        if (ret < 0)
+            return ret;
+    }
+
+    /*
+     * The only node a transform can have beside its child is an animation:
+     * without it, the matrix only changes on a live parameter change. The
+     * graph topology is frozen once attached, and so is the chain.
+     */
+    if (ngli_darray_count(children_array) > 1)
+        return 0;
+
+    if (!s->chain) {
+        s->chain = ngli_calloc(1, sizeof(*s->chain));
+        if (!s->chain)
+            return NGL_ERROR_MEMORY;
+    }
+
+    struct transform_chain *chain = s->chain;
+    chain->child = s->child;
+    if (is_transform(s->child)) {
+        const struct transform_priv *child = s->child->priv_data;
+        if (child->chain)
+            chain->child = child->chain->child;
+    }
+    chain->dirty = 1;
+
+    return 0;
+}
+
+static void update_chain_matrix(struct transform_priv *s)
+{
+    struct transform_chain *chain = s->chain;
+    if (!chain || !chain->dirty)
+        return;
+
+    if (chain->child == s->child) {
+        memcpy(chain->matrix, s->matrix, sizeof(chain->matrix));
+    } else {
+        struct transform_priv *child = s->child->priv_data;
+        update_chain_matrix(child);
+        ngli_mat4_mul(chain->matrix, s->matrix, child->chain->matrix);
+    }
+    chain->dirty = 0;
+}
+
+int ngli_transform_update(struct ngl_node *node, double t)
+{
+    /*
+     * The matrices of the static transforms are not affected by the update,
+     * so the chain can be refreshed before the child is updated.
+     */
+    struct transform_priv *s = node->priv_data;
+    update_chain_matrix(s);
+    return ngli_node_update(s->child, t);
+}
+
+/*
+ * A live change of any transform of a chain invalidates all its ancestors,
+ * including the head of the chain.
+ */
+int ngli_transform_invalidate(struct ngl_node *node)
+{
+    struct transform_priv *s = node->priv_data;
+    if (s->chain)
+        s->chain->dirty = 1;
+    return 0;
+}
+
+void ngli_transform_uninit(struct ngl_node *node)
+{
+    struct transform_priv *s = node->priv_data;
+    ngli_freep(&s->chain);
+}
+
 void ngli_transform_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct transform_priv *s = node->priv_data;
-    struct ngl_node *child = s->child;
+    const float *matrix = s->chain ? s->chain->matrix : s->matrix;
+    struct ngl_node *child = s->chain ? s->chain->child : s->child;
 
     float *next_matrix = ngli_darray_push(&ctx->modelview_matrix_stack, NULL);
     if (!next_matrix)
@@ -69,7 +183,21 @@ void ngli_transform_draw(struct ngl_node *node)
      * underlying matrix stack buffer */
     const float *prev_matrix = next_matrix - 4 * 4;
 
-    ngli_mat4_mul(next_matrix, prev_matrix, s->matrix);
+    ngli_mat4_mul(next_matrix, prev_matrix, matrix);
     ngli_node_draw(child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
+
+int ngli_transform_compile(struct ngl_node *node, struct drawlist *drawlist)
+{
+    struct transform_priv *s = node->priv_data;
+    const float *matrix = s->chain ? s->chain->matrix : s->matrix;
+    struct ngl_node *child = s->chain ? s->chain->child : s->child;
+
+    int ret = ngli_drawlist_push_matrix(drawlist, matrix);
+    if (ret < 0)
+        return ret;
+    ret = ngli_drawlist_add_node(drawlist, child);
+    ngli_drawlist_pop_matrix(drawlist);
+    return ret;
+}
@@ -25,6 +25,11 @@
 #include "nodes.h"
 
 const float *ngli_get_last_transformation_matrix(const struct ngl_node *node);
+int ngli_transform_prepare(struct ngl_node *node);
+int ngli_transform_update(struct ngl_node *node, double t);
+int ngli_transform_invalidate(struct ngl_node *node);
+void ngli_transform_uninit(struct ngl_node *node);
 void ngli_transform_draw(struct ngl_node *node);
+int ngli_transform_compile(struct ngl_node *node, struct drawlist *drawlist);
 
 #endif
@@ -25,9 +25,11 @@
 #define POW10_9 1000000000
 #include <Windows.h>
 #else
+#include <sys/mman.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
 #endif
@@ -170,15 +172,30 @@ void ngli_thread_set_name(const char *name)
 #endif
 }
 
+int ngli_get_nb_cpus(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#else
+    const long nb_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return nb_cpus > 0 ? nb_cpus : 1;
+#endif
+}
+
 int ngli_get_filesize(const char *filename, int64_t *size)
 {
 #ifdef _WIN32
     HANDLE file_handle = CreateFile(TEXT(filename), GENERIC_READ, 0, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    if (file_handle == INVALID_HANDLE_VALUE)
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        LOG(ERROR, "could not open '%s' (%lu)", filename, GetLastError());
         return NGL_ERROR_IO;
+    }
 
     LARGE_INTEGER file_size;
     if (!GetFileSizeEx(file_handle, &file_size)) {
+        LOG(ERROR, "could not get the size of '%s' (%lu)", filename, GetLastError());
         CloseHandle(file_handle);
         return NGL_ERROR_IO;
     }
@@ -196,6 +213,68 @@ int ngli_get_filesize(const char *filename, int64_t *size)
     return 0;
 }
 
+int ngli_map_file(const char *filename, int64_t size, void **datap)
+{
+    *datap = NULL;
+    if (!size)
+        return 0;
+
+#ifdef _WIN32
+    HANDLE file_handle = CreateFile(TEXT(filename), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        LOG(ERROR, "could not open '%s' (%lu)", filename, GetLastError());
+        return NGL_ERROR_IO;
+    }
+
+    HANDLE mapping_handle = CreateFileMapping(file_handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!mapping_handle) {
+        LOG(ERROR, "could not create a mapping of '%s' (%lu)", filename, GetLastError());
+        CloseHandle(file_handle);
+        return NGL_ERROR_IO;
+    }
+    CloseHandle(file_handle);
+
+    /* The view keeps a reference on the mapping */
+    void *data = MapViewOfFile(mapping_handle, FILE_MAP_COPY, 0, 0, size);
+    if (!data) {
+        LOG(ERROR, "could not map '%s' (%lu)", filename, GetLastError());
+        CloseHandle(mapping_handle);
+        return NGL_ERROR_IO;
+    }
+    CloseHandle(mapping_handle);
+#else
+    const int fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        LOG(ERROR, "could not open '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+
+    /* Private mapping: pages are only duplicated if they are written to */
+    void *data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        LOG(ERROR, "could not map '%s': %s", filename, strerror(errno));
+        return NGL_ERROR_IO;
+    }
+#endif
+
+    *datap = data;
+    return 0;
+}
+
+void ngli_unmap_file(void **datap, int64_t size)
+{
+    void *data = *datap;
+    if (!data)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+    *datap = NULL;
+}
+
 static int count_lines(const char *s)
 {
     int count = 0;
@@ -106,7 +106,15 @@ int64_t ngli_gettime_relative(void);
 char *ngli_asprintf(const char *fmt, ...) ngli_printf_format(1, 2);
 uint32_t ngli_crc32(const char *s);
 void ngli_thread_set_name(const char *name);
+int ngli_get_nb_cpus(void);
 int ngli_get_filesize(const char *name, int64_t *size);
+
+/*
+ * Map the first size bytes of a file in memory. The data is only read from
+ * the file when it is accessed, and writes are not reflected in the file.
+ */
+int ngli_map_file(const char *filename, int64_t size, void **datap);
+void ngli_unmap_file(void **datap, int64_t size);
 char *ngli_numbered_lines(const char *s);
 
 #endif /* UTILS_H */
@@ -93,6 +93,29 @@ static int opt_timerange(const char *arg, void *dst)
     return 0;
 }
 
+struct frame_ctx {
+    const struct ctx *s;
+    int range_id;
+    int fd;
+    const uint8_t *capture_buffer;
+};
+
+/* Called from the node.gl worker thread after each frame */
+static int frame_callback(void *user_arg, int index, double t)
+{
+    const struct frame_ctx *frame_ctx = user_arg;
+    const struct ctx *s = frame_ctx->s;
+
+    if (s->debug) {
+        const struct range *r = &s->ranges[frame_ctx->range_id];
+        printf("drawn @ t=%f [range %d/%d: %g-%g @ %dHz]\n",
+               t, frame_ctx->range_id + 1, s->nb_ranges, r->start, r->start + r->duration, r->freq);
+    }
+    if (frame_ctx->capture_buffer)
+        write(frame_ctx->fd, frame_ctx->capture_buffer, 4 * s->cfg.width * s->cfg.height);
+    return 0;
+}
+
 #define OFFSET(x) offsetof(struct ctx, x)
 static const struct opt options[] = {
     {"-d", "--debug",         OPT_TYPE_TOGGLE,   .offset=OFFSET(debug)},
@@ -107,6 +130,7 @@ static const struct opt options[] = {
     {"-z", "--swap_interval", OPT_TYPE_INT,      .offset=OFFSET(cfg.swap_interval)},
     {"-c", "--clear_color",   OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {"-j", "--update_threads", OPT_TYPE_INT,     .offset=OFFSET(cfg.nb_update_threads)},
 };
 
 int main(int argc, char *argv[])
@@ -212,38 +236,60 @@ int main(int argc, char *argv[])
         goto end;
 
     for (int i = 0; i < s.nb_ranges; i++) {
-        int k = 0;
         const struct range *r = &s.ranges[i];
         const float t0 = r->start;
         const float t1 = r->start + r->duration;
 
+        int nb_frames = 0;
+        while ((float)(t0 + nb_frames*1./r->freq) < t1)
+            nb_frames++;
+        if (!nb_frames) {
+            printf("Range %d/%d is empty, skipping\n", i + 1, s.nb_ranges);
+            continue;
+        }
+
+        double *times = malloc(nb_frames * sizeof(*times));
+        if (!times) {
+            ret = EXIT_FAILURE;
+            goto end;
+        }
+        for (int k = 0; k < nb_frames; k++)
+            times[k] = (float)(t0 + k*1./r->freq);
+
+        struct frame_ctx frame_ctx = {
+            .s = &s,
+            .range_id = i,
+            .fd = fd,
+            .capture_buffer = capture_buffer,
+        };
+
+        /*
+         * The SDL events can only be polled from this thread, so the window
+         * is kept responsive by drawing its frames one at a time.
+         */
+        const int batch_size = s.cfg.offscreen ? nb_frames : 1;
+
         const int64_t start = gettime_relative();
 
-        for (;;) {
-            const float t = t0 + k*1./r->freq;
-            if (t >= t1)
+        for (int k = 0; k < nb_frames; k += batch_size) {
+            ret = ngl_draw_range(ctx, times + k, batch_size, frame_callback, &frame_ctx);
+            if (ret < 0)
                 break;
-            if (s.debug)
-                printf("draw @ t=%f [range %d/%d: %g-%g @ %dHz]\n",
-                       t, i + 1, s.nb_ranges, t0, t1, r->freq);
-            ret = ngl_draw(ctx, t);
-            if (ret < 0) {
-                fprintf(stderr, "Unable to draw @ t=%g\n", t);
-                goto end;
-            }
-            if (capture_buffer)
-                write(fd, capture_buffer, 4 * s.cfg.width * s.cfg.height);
+
             if (!s.cfg.offscreen) {
                 SDL_Event event;
                 while (SDL_PollEvent(&event)) {
                 }
             }
-
-            k++;
+        }
+        free(times);
+        if (ret < 0) {
+            fprintf(stderr, "Unable to draw range %d/%d\n", i + 1, s.nb_ranges);
+            goto end;
         }
 
         const double tdiff = (gettime_relative() - start) / 1000000.;
-        printf("Rendered %d frames in %g (FPS=%g)\n", k, tdiff, k / tdiff);
+        printf("Rendered %d frames in %g (FPS=%g)\n", nb_frames, tdiff, nb_frames / tdiff);
     }
 
 end:
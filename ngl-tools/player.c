@@ -621,8 +621,9 @@ void player_main_loop(void)
     int run = 1;
     while (run) {
         update_time(-1);
+        ngl_wait(p->ngl);
         update_pgbar();
-        ngl_draw(p->ngl, p->frame_time);
+        ngl_draw_async(p->ngl, p->frame_time);
         if (p->seeking) {
             reset_running_time();
             p->seeking = 0;
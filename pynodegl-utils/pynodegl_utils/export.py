@@ -111,13 +111,15 @@ class Exporter(QtCore.QThread):
         else:
             # Draw every frame
             nb_frame = int(duration * fps[0] / fps[1])
-            for i in range(nb_frame):
-                if self._cancelled:
-                    break
-                time = i * fps[1] / float(fps[0])
-                ctx.draw(time)
+            times = [i * fps[1] / float(fps[0]) for i in range(nb_frame)]
+
+            # Called from the node.gl worker thread after each frame
+            def write_frame(i, time):
                 os.write(fd_w, capture_buffer)
                 self.progressed.emit(i*100 / nb_frame)
+                return -1 if self._cancelled else 0
+
+            ctx.draw_range(times, write_frame)
             self.progressed.emit(100)
 
         os.close(fd_w)
@@ -21,10 +21,15 @@
 #
 
 from libc.stdlib cimport calloc
+from libc.stdlib cimport free
 from libc.string cimport memset
+from libc.stdint cimport int64_t
 from libc.stdint cimport uint8_t
 from libc.stdint cimport uint32_t
 from libc.stdint cimport uintptr_t
+from cpython cimport array
+
+import array
 
 cdef extern from "nodegl.h":
     cdef int NGL_LOG_VERBOSE
@@ -50,6 +55,9 @@ cdef extern from "nodegl.h":
     ngl_node *ngl_node_deserialize(const char *s)
 
     int ngl_anim_evaluate(ngl_node *anim, void *dst, double t)
+    int ngl_anim_evaluate_array(ngl_node *anim, void *dst, const double *t, int nb_values)
+
+    int ngl_streamed_push(ngl_node *node, int64_t ts, const void *data, int size)
 
     cdef int NGL_PLATFORM_AUTO
     cdef int NGL_PLATFORM_XLIB
@@ -109,6 +117,9 @@ cdef extern from "nodegl.h":
         int hud_refresh_rate[2]
         const char *hud_export_filename
         int hud_scale
+        int nb_update_threads
+        float lookahead_time
+        int lookahead_budget
 
     ngl_ctx *ngl_create()
     int ngl_backends_probe(const ngl_config *user_config, int *nb_backendsp, ngl_backend **backendsp)
@@ -119,6 +130,13 @@ cdef extern from "nodegl.h":
     int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer);
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
+    ctypedef int (*ngl_draw_callback)(void *user_arg, int index, double t) except? -1
+    int ngl_draw_range(ngl_ctx *s, const double *times, int nb_times,
+                       ngl_draw_callback callback, void *user_arg) nogil
+    int ngl_draw_async(ngl_ctx *s, double t) nogil
+    int ngl_wait(ngl_ctx *s) nogil
+    int ngl_node_params_begin(ngl_ctx *s)
+    int ngl_node_params_commit(ngl_ctx *s)
     char *ngl_dot(ngl_ctx *s, double t) nogil
     void ngl_freep(ngl_ctx **ss)
 
@@ -126,6 +144,10 @@ cdef extern from "nodegl.h":
                             const double *offsets, double t, double *v)
     int ngl_easing_derivate(const char *name, const double *args, int nb_args,
                             const double *offsets, double t, double *v)
+    int ngl_easing_evaluate_array(const char *name, const double *args, int nb_args,
+                                  const double *offsets, const double *t, double *v, int nb_values)
+    int ngl_easing_derivate_array(const char *name, const double *args, int nb_args,
+                                  const double *offsets, const double *t, double *v, int nb_values)
     int ngl_easing_solve(const char *name, const double *args, int nb_args,
                          const double *offsets, double v, double *t)
 
@@ -174,9 +196,7 @@ def log_set_min_level(int level):
 _ANIM_EVALUATE, _ANIM_DERIVATE, _ANIM_SOLVE = range(3)
 
 
-cdef _animate(name, src, args, offsets, mode):
-    cdef double c_args[2]
-    cdef double *c_args_param = NULL
+cdef int _get_easing_params(args, offsets, double *c_args, double *c_offsets) except -1:
     cdef int nb_args = 0
     if args is not None:
         nb_args = len(args)
@@ -184,13 +204,21 @@ cdef _animate(name, src, args, offsets, mode):
             raise Exception("Easings do not support more than 2 arguments")
         for i, arg in enumerate(args):
             c_args[i] = arg
-        c_args_param = c_args
+    if offsets is not None:
+        c_offsets[0] = offsets[0]
+        c_offsets[1] = offsets[1]
+    return nb_args
+
 
+cdef _animate(name, src, args, offsets, mode):
+    cdef double c_args[2]
     cdef double c_offsets[2]
+    cdef int nb_args = _get_easing_params(args, offsets, c_args, c_offsets)
+    cdef double *c_args_param = NULL
     cdef double *c_offsets_param = NULL
+    if args is not None:
+        c_args_param = c_args
     if offsets is not None:
-        c_offsets[0] = offsets[0]
-        c_offsets[1] = offsets[1]
         c_offsets_param = c_offsets
 
     cdef double dst
@@ -225,6 +253,55 @@ def easing_solve(name, v, args=None, offsets=None):
     return _animate(name, v, args, offsets, _ANIM_SOLVE)
 
 
+cdef _animate_array(name, src, dst, args, offsets, mode):
+    cdef double c_args[2]
+    cdef double c_offsets[2]
+    cdef int nb_args = _get_easing_params(args, offsets, c_args, c_offsets)
+    cdef double *c_args_param = NULL
+    cdef double *c_offsets_param = NULL
+    if args is not None:
+        c_args_param = c_args
+    if offsets is not None:
+        c_offsets_param = c_offsets
+
+    cdef const double[::1] c_src = src
+    cdef int nb_values = c_src.shape[0]
+    if dst is None:
+        dst = array.clone(array.array('d'), nb_values, zero=False)
+    cdef double[::1] c_dst = dst
+    if c_dst.shape[0] < nb_values:
+        raise ValueError(f'Output buffer can not hold {nb_values} values')
+    if not nb_values:
+        return dst
+
+    cdef int ret
+    if mode == _ANIM_EVALUATE:
+        ret = ngl_easing_evaluate_array(name, c_args_param, nb_args, c_offsets_param,
+                                        &c_src[0], &c_dst[0], nb_values)
+        if ret < 0:
+            raise Exception(f'Error evaluating {name}')
+    elif mode == _ANIM_DERIVATE:
+        ret = ngl_easing_derivate_array(name, c_args_param, nb_args, c_offsets_param,
+                                        &c_src[0], &c_dst[0], nb_values)
+        if ret < 0:
+            raise Exception(f'Error derivating {name}')
+    else:
+        raise Exception(f'Unknown mode {mode}')
+
+    return dst
+
+
+# t can be any contiguous buffer of doubles (array.array('d'), NumPy float64
+# array, ...). The values are written in out if specified (with the same
+# requirements), otherwise in a new array.array, which is returned.
+def easing_evaluate_array(name, t, args=None, offsets=None, out=None):
+    return _animate_array(name, t, out, args, offsets, _ANIM_EVALUATE)
+
+
+def easing_derivate_array(name, t, args=None, offsets=None, out=None):
+    return _animate_array(name, t, out, args, offsets, _ANIM_DERIVATE)
+
+
 cdef _set_node_ctx(_Node node, int type):
     assert node.ctx is NULL
     node.ctx = ngl_node_create(type)
@@ -283,6 +360,18 @@ def get_backends(**kwargs):
     return _probe_backends(_PROBE_MODE_NO_GRAPHICS, **kwargs)
 
 
+cdef int _draw_range_callback(void *user_arg, int index, double t) except? -1 with gil:
+    # Exceptions can not cross the worker thread: they are stored in the state
+    # and raised again by Context.draw_range()
+    state = <object>user_arg
+    try:
+        ret = state[0](index, t)
+    except BaseException as e:
+        state[1] = e
+        return -1
+    return ret if ret is not None and ret < 0 else 0
+
+
 cdef class Context:
     cdef ngl_ctx *ctx
     cdef object capture_buffer
@@ -325,6 +414,9 @@ cdef class Context:
         if hud_export_filename is not None:
             config.hud_export_filename = hud_export_filename
         config.hud_scale = kwargs.get('hud_scale', 0)
+        config.nb_update_threads = kwargs.get('nb_update_threads', 0)
+        config.lookahead_time = kwargs.get('lookahead_time', 0.0)
+        config.lookahead_budget = kwargs.get('lookahead_budget', 0)
 
     def configure(self, **kwargs):
         self.capture_buffer = kwargs.get('capture_buffer')
@@ -362,6 +454,41 @@ cdef class Context:
             ret = ngl_draw(self.ctx, t)
         return ret
 
+    def draw_range(self, times, callback=None):
+        cdef int nb_times = len(times)
+        cdef double *c_times = <double *>calloc(max(nb_times, 1), sizeof(double))
+        if c_times is NULL:
+            raise MemoryError()
+        for i in range(nb_times):
+            c_times[i] = times[i]
+        cdef ngl_draw_callback c_callback = NULL
+        if callback is not None:
+            c_callback = _draw_range_callback
+        state = [callback, None]
+        cdef void *c_state = <void *>state
+        with nogil:
+            ret = ngl_draw_range(self.ctx, c_times, nb_times, c_callback, c_state)
+        free(c_times)
+        if state[1] is not None:
+            raise state[1]
+        return ret
+
+    def draw_async(self, double t):
+        with nogil:
+            ret = ngl_draw_async(self.ctx, t)
+        return ret
+
+    def wait(self):
+        with nogil:
+            ret = ngl_wait(self.ctx)
+        return ret
+
+    def params_begin(self):
+        return ngl_node_params_begin(self.ctx)
+
+    def params_commit(self):
+        return ngl_node_params_commit(self.ctx)
+
     def dot(self, double t):
         cdef char *s;
         with nogil:
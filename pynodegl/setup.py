@@ -82,6 +82,8 @@ class CommandUtils:
 '''
 
         content = 'from libc.stdlib cimport free\n'
+        content += 'from libc.stdint cimport int64_t\n'
+        content += 'from libc.stdint cimport uint8_t\n'
         content += 'from libc.stdint cimport uintptr_t\n'
         content += 'from cpython cimport array\n'
 
@@ -283,6 +285,29 @@ cdef class {node}({parent_node}):
         cdef float[{n}] vec
         ngl_anim_evaluate(self.ctx, vec, t)
         return {retstr}
+
+    def evaluate_array(self, t, out=None):
+        cdef const double[::1] c_t = t
+        cdef int nb_values = c_t.shape[0]
+        if out is None:
+            out = array.clone(array.array('f'), nb_values * {n}, zero=False)
+        cdef float[::1] c_out = out
+        if c_out.shape[0] < nb_values * {n}:
+            raise ValueError(f'Output buffer can not hold {{nb_values}} values of {n} floats')
+        if nb_values and ngl_anim_evaluate_array(self.ctx, &c_out[0], &c_t[0], nb_values) < 0:
+            raise Exception('Error evaluating the animation')
+        return out
+'''
+
+            # Streamed classes in live mode are fed through a push method
+            if node.startswith('Streamed'):
+                class_str += '''
+    def push(self, int64_t ts, data):
+        cdef const uint8_t[::1] c_data = memoryview(data).cast('B')
+        if c_data.shape[0] == 0:
+            raise ValueError('Can not push an empty sample')
+        if ngl_streamed_push(self.ctx, ts, &c_data[0], c_data.shape[0]) < 0:
+            raise Exception('Error pushing data to the stream')
 '''
 
             # Declare a set, add or update method for every optional field of
@@ -20,6 +20,7 @@
 # under the License.
 #
 
+import array
 import itertools
 import random
 import pynodegl as ngl
@@ -83,6 +84,7 @@ def anim_forward_api(nb_points=7):
         easing_name, easing_args = _easing_split(easing)
         for offsets in _offsets:
             values = [ngl.easing_evaluate(easing_name, t, easing_args, offsets) for t in times]
+            assert list(ngl.easing_evaluate_array(easing_name, array.array('d', times), easing_args, offsets)) == values
             ret.append([easing_name] + values)
     return ret
 
@@ -149,6 +151,7 @@ def anim_derivative_api(nb_points=7):
         easing_name, easing_args = _easing_split(easing)
         for offsets in _offsets:
             values = [ngl.easing_derivate(easing_name, t, easing_args, offsets) for t in times]
+            assert list(ngl.easing_derivate_array(easing_name, array.array('d', times), easing_args, offsets)) == values
             ret.append([easing_name] + values)
     return ret
 
@@ -207,6 +210,10 @@ def _get_anim_func(size, animated_type, kf_func, velocity_type=None):
 
             if hasattr(values[0], '__iter__'):
                 values = list(itertools.chain(*values))
+
+            # The batched evaluation must match the individual queries
+            times = [(t_id + 1) * scale for t_id in range(nb_queries)] + [0, 1, 5]
+            assert list(anim.evaluate_array(array.array('d', times))) == values
             ret.append(['off%d' % i] + values)
 
         return ret
@@ -197,3 +197,42 @@ def api_media_sharing_failure():
     m = ngl.Media('/dev/null')
     scene = ngl.Group(children=(m, m))
     assert _ret_to_fourcc(ctx.set_scene(scene)) == 'Eusg'  # Usage error
+
+
+def api_prefetch_failure():
+    ctx = ngl.Context()
+    assert ctx.configure(offscreen=1, width=16, height=16, backend=_backend) == 0
+    frag = 'void main() { ngl_out_color = texture(tex, vec2(0.0)); }'
+
+    # Buffers referencing a block are rejected as texture data source when
+    # prefetching, and this Render is only active until t=1
+    block = ngl.Block(fields=(ngl.BufferVec4(count=4),))
+    bad_tex = ngl.Texture2D(width=2, height=2, data_src=ngl.BufferVec4(count=4, block=block))
+    bad_render = ngl.Render(ngl.Quad(), ngl.Program(vertex=_vert, fragment=frag))
+    bad_render.update_frag_resources(tex=bad_tex)
+    ranges = (ngl.TimeRangeModeCont(0), ngl.TimeRangeModeNoop(1))
+    bad_branch = ngl.TimeRangeFilter(bad_render, ranges=ranges, prefetch_time=0, max_idle_time=0.5)
+
+    # The prefetch of this texture comes after the failing one
+    good_render = ngl.Render(ngl.Quad(), ngl.Program(vertex=_vert, fragment=frag))
+    good_render.update_frag_resources(tex=ngl.Texture2D(width=2, height=2))
+
+    scene = ngl.Group(children=(bad_branch, good_render))
+    assert ctx.set_scene(scene) == 0
+    assert _ret_to_fourcc(ctx.draw(0)) == 'Esup'  # Unsupported
+    assert ctx.draw(2) == 0
+    assert ctx.draw(3) == 0
+    del ctx
+
+
+def api_anim_keyframe_time_change():
+    kf1 = ngl.AnimKeyFrameFloat(1, 1, easing='quadratic_in')
+    anim = ngl.AnimatedFloat([ngl.AnimKeyFrameFloat(0, 0), kf1])
+    velocity = ngl.VelocityFloat(anim)
+    assert anim.evaluate(0.5) == 0.25
+    assert velocity.evaluate(0.5) == 1.0
+
+    # The key frame times can still change after the first evaluation
+    assert kf1.set_time(2) == 0
+    assert anim.evaluate(0.5) == 0.0625
+    assert velocity.evaluate(0.5) == 0.5
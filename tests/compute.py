@@ -292,3 +292,103 @@ def compute_animation(cfg):
     render.update_frag_resources(color=ngl.UniformVec4(value=COLORS.sgreen))
 
     return ngl.Group(children=(compute, render))
+
+
+_NOISE_FIELD_PARAMS = dict(
+    frequency=0.8,
+    amplitude=0.9,
+    octaves=6,
+    lacunarity=1.9,
+    gain=0.6,
+    seed=0x4d4f6f7,
+)
+
+_NOISE_FIELD_SIZE = 4
+
+
+def _get_noise_field_cuepoints():
+    f = float(_NOISE_FIELD_SIZE)
+    off = 1 / (2 * f)
+    c = lambda i: (i / f + off) * 2.0 - 1.0
+    n = _NOISE_FIELD_SIZE
+    return {'%d%d' % (x, y): (c(x), c(y)) for y in range(n) for x in range(n)}
+
+
+_NOISE_FIELD_BUFFER_VERT = '''
+void main()
+{
+    vec2 cell = vec2(float(ngl_instance_index %% %(size)d), float(ngl_instance_index / %(size)d));
+    ngl_out_pos = vec4((cell + ngl_position.xy) / %(size)d.0 * 2.0 - 1.0, 0.0, 1.0);
+    var_color = vec4(field.rgb * 0.5 + 0.5, 1.0);
+}
+'''
+
+
+_NOISE_FIELD_BUFFER_FRAG = '''
+void main()
+{
+    ngl_out_color = var_color;
+}
+'''
+
+
+_NOISE_FIELD_TEXTURE_VERT = '''
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    var_uvcoord = ngl_uvcoord;
+}
+'''
+
+
+_NOISE_FIELD_TEXTURE_FRAG = '''
+void main()
+{
+    ivec2 size = textureSize(field, 0);
+    vec4 value = texelFetch(field, ivec2(var_uvcoord * vec2(size)), 0);
+    ngl_out_color = vec4(value.rgb * 0.5 + 0.5, 1.0);
+}
+'''
+
+
+@test_cuepoints(points=_get_noise_field_cuepoints(), nb_keyframes=5, tolerance=1)
+@scene()
+def compute_noise_field_buffer(cfg):
+    '''
+    A 4x4 grid of cells, each one drawn with an instance reading its vec4
+    from the noise field buffer
+    '''
+    cfg.duration = 5
+    cfg.aspect_ratio = (1, 1)
+    size = _NOISE_FIELD_SIZE
+    field = ngl.BufferVec4(count=size * size)
+    noise_field = ngl.NoiseField(target=field, **_NOISE_FIELD_PARAMS)
+
+    quad = ngl.Quad((0, 0, 0), (1, 0, 0), (0, 1, 0))
+    vertex = _NOISE_FIELD_BUFFER_VERT % dict(size=size)
+    program = ngl.Program(vertex=vertex, fragment=_NOISE_FIELD_BUFFER_FRAG)
+    program.update_vert_out_vars(var_color=ngl.IOVec4())
+    render = ngl.Render(quad, program, nb_instances=size * size)
+    render.update_instance_attributes(field=field)
+    return ngl.Group(children=(noise_field, render))
+
+
+@test_cuepoints(points=_get_noise_field_cuepoints(), nb_keyframes=5, tolerance=1)
+@scene()
+def compute_noise_field_texture(cfg):
+    '''
+    Same as compute_noise_field_buffer, with the field generated in the
+    texels of a 4x4 texture
+    '''
+    cfg.duration = 5
+    cfg.aspect_ratio = (1, 1)
+    size = _NOISE_FIELD_SIZE
+    field = ngl.Texture2D(width=size, height=size, format='r32g32b32a32_sfloat')
+    noise_field = ngl.NoiseField(target=field, **_NOISE_FIELD_PARAMS)
+
+    quad = ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=_NOISE_FIELD_TEXTURE_VERT, fragment=_NOISE_FIELD_TEXTURE_FRAG)
+    program.update_vert_out_vars(var_uvcoord=ngl.IOVec2())
+    render = ngl.Render(quad, program)
+    render.update_frag_resources(field=field)
+    return ngl.Group(children=(noise_field, render))
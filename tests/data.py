@@ -330,6 +330,72 @@ data_streamed_buffer_vec4 = _get_data_streamed_buffer_function(1, False)
 data_streamed_buffer_vec4_time_anim = _get_data_streamed_buffer_function(2, False)
 
 
+_BLOCK_PARTIAL_UPLOAD_FRAG = '''
+void main()
+{
+    int i = clamp(int(var_uvcoord.x * 5.0), 0, 4);
+    ngl_out_color = i == 0 ? blk.a
+                  : i == 1 ? blk.pad0[5]
+                  : i == 2 ? blk.b
+                  : i == 3 ? blk.pad1[20]
+                  : blk.c;
+}
+'''
+
+
+def _get_block_partial_upload_cuepoints():
+    names = ('a', 'pad0', 'b', 'pad1', 'c')
+    c = lambda i: (i + 0.5) / len(names) * 2.0 - 1.0
+    rows = dict(top=0.5, bottom=-0.5)
+    return {f'{row}_{name}': (c(i), y) for row, y in rows.items() for i, name in enumerate(names)}
+
+
+@test_cuepoints(points=_get_block_partial_upload_cuepoints(), nb_keyframes=5, tolerance=1)
+@scene()
+def data_block_partial_upload(cfg):
+    '''
+    Animated fields around static arrays: a and b are close enough to be
+    uploaded in a single range (including pad0), c is uploaded separately.
+    The block is shared by 2 renders (the second one does not upload it
+    again) and it is not drawn at all at t=2.
+    '''
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 5
+
+    def get_anim(label, values):
+        kfs = [ngl.AnimKeyFrameVec4(i * 2, v) for i, v in enumerate(values)]
+        return ngl.AnimatedVec4(kfs, label=label)
+
+    a = get_anim('a', ((0.1, 0.2, 0.3, 1.0), (0.9, 0.5, 0.1, 1.0), (0.3, 0.8, 0.6, 1.0)))
+    b = get_anim('b', ((0.7, 0.1, 0.4, 1.0), (0.2, 0.9, 0.8, 1.0), (0.6, 0.3, 0.9, 1.0)))
+    c = get_anim('c', ((0.5, 0.5, 0.0, 1.0), (0.0, 0.3, 1.0, 1.0), (1.0, 0.6, 0.2, 1.0)))
+    pad0 = array.array('f')
+    for i in range(8):
+        pad0.extend((i / 8, 1 - i / 8, 0.5, 1.0))
+    pad1 = array.array('f')
+    for i in range(32):
+        pad1.extend((0.25, i / 32, 1 - i / 32, 1.0))
+    fields = (
+        a,
+        ngl.BufferVec4(data=pad0, label='pad0'),  # 128 bytes
+        b,
+        ngl.BufferVec4(data=pad1, label='pad1'),  # 512 bytes
+        c,
+    )
+    block = ngl.Block(fields=fields, layout='std140')
+
+    program = ngl.Program(vertex=_RENDER_STREAMEDBUFFER_VERT, fragment=_BLOCK_PARTIAL_UPLOAD_FRAG)
+    program.update_vert_out_vars(var_uvcoord=ngl.IOVec2())
+    renders = []
+    for y in (0, -1):
+        render = ngl.Render(ngl.Quad((-1, y, 0), (2, 0, 0), (0, 1, 0)), program)
+        render.update_frag_resources(blk=block)
+        renders.append(render)
+
+    ranges = (ngl.TimeRangeModeCont(0), ngl.TimeRangeModeNoop(1.5), ngl.TimeRangeModeCont(2.5))
+    return ngl.TimeRangeFilter(ngl.Group(children=renders), ranges=ranges)
+
+
 @test_cuepoints(points={'c': (0, 0)}, tolerance=1)
 @scene()
 def data_integer_iovars(cfg):
@@ -350,6 +416,48 @@ def data_integer_iovars(cfg):
     return render
 
 
+def _get_data_animated_buffer_vec3(cfg, gpu_eval):
+    # Two triangles covering the center, with values not exactly representable
+    # once interpolated
+    quad = (-1, -1, 0, 1, -1, 0, 1, 1, 0, -1, -1, 0, 1, 1, 0, -1, 1, 0)
+    scales = (0.3, 0.95, 0.5)
+    keyframes = []
+    for i, scale in enumerate(scales):
+        data = array.array('f', (v * scale * (1 + j / 37.) for j, v in enumerate(quad)))
+        easing = 'quadratic_in_out' if i else 'linear'
+        keyframes.append(ngl.AnimKeyFrameBuffer(cfg.duration * i / (len(scales) - 1), data, easing))
+    return ngl.AnimatedBufferVec3(keyframes=keyframes, gpu_eval=gpu_eval)
+
+
+@test_cuepoints(points={'c': (0, 0)}, nb_keyframes=10)
+@scene()
+def data_animated_buffer_gpu_eval(cfg):
+    '''The GPU evaluation must match the CPU one exactly: green if the
+    vertices evaluated on the CPU and on the GPU are identical, red otherwise'''
+    cfg.aspect_ratio = (1, 1)
+    cfg.duration = 3
+    vert = '''
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position, 1.0);
+    var_color = all(equal(ngl_position, ngl_normal)) ? vec4(0.0, 1.0, 0.0, 1.0) : vec4(1.0, 0.0, 0.0, 1.0);
+}
+'''
+    frag = '''
+void main()
+{
+    ngl_out_color = var_color;
+}
+'''
+    geometry = ngl.Geometry(
+        vertices=_get_data_animated_buffer_vec3(cfg, gpu_eval=False),
+        normals=_get_data_animated_buffer_vec3(cfg, gpu_eval=True),
+    )
+    program = ngl.Program(vertex=vert, fragment=frag)
+    program.update_vert_out_vars(var_color=ngl.IOVec4())
+    return ngl.Render(geometry, program)
+
+
 @test_fingerprint(nb_keyframes=10, tolerance=1)
 @scene()
 def data_noise_time(cfg):
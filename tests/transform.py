@@ -26,6 +26,8 @@ import random
 import pynodegl as ngl
 from pynodegl_utils.misc import scene
 from pynodegl_utils.toolbox.colors import COLORS
+from pynodegl_utils.tests.debug import get_debug_points
+from pynodegl_utils.tests.cmp_cuepoints import test_cuepoints
 from pynodegl_utils.tests.cmp_fingerprint import test_fingerprint
 from pynodegl_utils.toolbox.shapes import equilateral_triangle_coords
 
@@ -310,3 +312,68 @@ def transform_smoothpath(cfg):
     ]
 
     return ngl.Translate(shape, anim=ngl.AnimatedPath(anim_kf, path))
+
+
+_LIVE_CHAIN_CUEPOINTS = dict(
+    c=( 0.05, -0.05),
+    e=( 0.65, -0.05),
+    n=( 0.05,  0.55),
+    s=( 0.05, -0.65),
+    w=(-0.55, -0.05),
+)
+
+
+def _get_transform_live_chain_function():
+    nodes = {}
+
+    def reset_chain():
+        nodes['rotate'].set_angle(0)
+        nodes['translate'].set_vector(0.4, 0, 0)
+
+    livechange_funcs = (
+        lambda: nodes['rotate'].set_angle(90),              # step=1
+        lambda: nodes['rotate'].set_angle(180),             # step=2
+        lambda: nodes['rotate'].set_angle(270),             # step=3
+        lambda: nodes['translate'].set_vector(0, 0, 0),     # step=4
+        reset_chain,                                        # step=5
+    )
+
+    def keyframes_callback(t_id):
+        if t_id:
+            livechange_funcs[t_id - 1]()
+
+    @test_cuepoints(points=_LIVE_CHAIN_CUEPOINTS,
+                    nb_keyframes=len(livechange_funcs) + 1,
+                    keyframes_callback=keyframes_callback,
+                    tolerance=1,
+                    exercise_serialization=False,
+                    debug_positions=False)
+    @scene(step=scene.Range(range=[0, len(livechange_funcs)]),
+           debug_positions=scene.Bool())
+    def scene_func(cfg, step=0, debug_positions=True):
+        '''
+        The Rotate in the middle of a chain of static transforms is changed
+        live (and then the innermost Translate): the quad must land where a
+        freshly built scene with the same parameters (see step) puts it
+        '''
+        cfg.duration = 0
+        cfg.aspect_ratio = (1, 1)
+        quad = ngl.Quad((-0.2, -0.2, 0), (0.4, 0, 0), (0, 0.4, 0))
+        prog = ngl.Program(vertex=cfg.get_vert('color'), fragment=cfg.get_frag('color'))
+        render = ngl.Render(quad, prog)
+        render.update_frag_resources(color=ngl.UniformVec4(value=COLORS.green))
+
+        nodes['translate'] = ngl.Translate(render, vector=(0.4, 0, 0))
+        nodes['rotate'] = ngl.Rotate(nodes['translate'], angle=0)
+        scale = ngl.Scale(nodes['rotate'], factors=(1.5, 1.5, 1))
+        root = ngl.Translate(scale, vector=(0.05, -0.05, 0))
+        for i in range(step):
+            livechange_funcs[i]()
+
+        if debug_positions:
+            return ngl.Group(children=(root, get_debug_points(cfg, _LIVE_CHAIN_CUEPOINTS)))
+        return root
+    return scene_func
+
+
+transform_live_chain = _get_transform_live_chain_function()